@@ -8,8 +8,12 @@
 #include <iostream>
 #include <chrono>
 #include <fstream>
+#include <memory>
+#include <atomic>
 #include <omp.h>
 
+#include "../common/memory_counter.h"
+
 struct Point
 {
     float x, y;
@@ -20,10 +24,22 @@ struct LineSegment
     Point start, end;
 };
 
+// Contadores por fase; el total y el allocator están en common/memory_counter.h
+MemoryCounter fieldMemory, segmentMemory;
+
+using ScalarField = std::vector<float, CountingAllocator<float, &fieldMemory>>;
+
 float EPS = 1e-6f;
+
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     if (std::fabs(denom) < EPS)
         return p1;
@@ -34,6 +50,166 @@ Point lerp(Point p1, Point p2, float v1, float v2, float iso)
             p1.y + t * (p2.y - p1.y)};
 }
 
+// Bloques de tamaño fijo: 16384 segmentos * 16 B = 256 KB por bloque
+constexpr std::size_t SEGMENTS_PER_CHUNK = 16384;
+
+struct SegmentChunk
+{
+    LineSegment data[SEGMENTS_PER_CHUNK];
+};
+
+// Pool compartido de bloques
+// Los bloques se crean sin inicializar, así que solo se tocan las páginas que realmente se usan
+class ChunkPool
+{
+public:
+    ~ChunkPool()
+    {
+        for (SegmentChunk *chunk : owned)
+            allocator.deallocate(chunk, 1);
+    }
+
+    SegmentChunk *acquire()
+    {
+        SegmentChunk *chunk = nullptr;
+
+        #pragma omp critical(chunk_pool)
+        {
+            if (freeChunks.empty())
+            {
+                chunk = allocator.allocate(1);
+                owned.push_back(chunk);
+            }
+            else
+            {
+                chunk = freeChunks.back();
+                freeChunks.pop_back();
+            }
+        }
+
+        return chunk;
+    }
+
+    void release(SegmentChunk *chunk)
+    {
+        #pragma omp critical(chunk_pool)
+        freeChunks.push_back(chunk);
+    }
+
+private:
+    CountingAllocator<SegmentChunk, &segmentMemory> allocator;
+    std::vector<SegmentChunk *> owned;
+    std::vector<SegmentChunk *> freeChunks;
+};
+
+// Arena por hilo: una lista de bloques pedidos al pool
+// Crecer no copia nada, solo se pide un bloque más
+// clear() conserva los bloques para reutilizarlos en la siguiente llamada
+class alignas(64) SegmentArena
+{
+public:
+    class const_iterator
+    {
+    public:
+        const_iterator(const SegmentArena *arena, std::size_t index) : arena(arena), index(index) {}
+
+        const LineSegment &operator*() const
+        {
+            return arena->chunks[index / SEGMENTS_PER_CHUNK]->data[index % SEGMENTS_PER_CHUNK];
+        }
+
+        const_iterator &operator++()
+        {
+            ++index;
+            return *this;
+        }
+
+        bool operator!=(const const_iterator &other) const { return index != other.index; }
+
+    private:
+        const SegmentArena *arena;
+        std::size_t index;
+    };
+
+    explicit SegmentArena(ChunkPool *pool) : pool(pool) {}
+
+    ~SegmentArena() { release(); }
+
+    SegmentArena(const SegmentArena &) = delete;
+    SegmentArena &operator=(const SegmentArena &) = delete;
+
+    void push_back(const LineSegment &segment)
+    {
+        if (cursor == limit)
+            nextChunk();
+
+        *cursor++ = segment;
+    }
+
+    std::size_t size() const
+    {
+        if (cursor == nullptr)
+            return 0;
+
+        return currentChunk * SEGMENTS_PER_CHUNK + (cursor - chunks[currentChunk]->data);
+    }
+
+    // Vuelve al primer bloque sin liberar memoria
+    void clear()
+    {
+        currentChunk = 0;
+        cursor = chunks.empty() ? nullptr : chunks[0]->data;
+        limit = chunks.empty() ? nullptr : chunks[0]->data + SEGMENTS_PER_CHUNK;
+    }
+
+    // Devuelve todos los bloques al pool
+    void release()
+    {
+        for (SegmentChunk *chunk : chunks)
+            pool->release(chunk);
+
+        chunks.clear();
+        currentChunk = 0;
+        cursor = limit = nullptr;
+    }
+
+    const_iterator begin() const { return const_iterator(this, 0); }
+    const_iterator end() const { return const_iterator(this, size()); }
+
+    // Copia contigua bajo demanda, bloque por bloque
+    void flattenInto(std::vector<LineSegment> &out) const
+    {
+        std::size_t remaining = size();
+        out.reserve(out.size() + remaining);
+
+        for (std::size_t c = 0; remaining > 0; ++c)
+        {
+            std::size_t count = std::min(remaining, SEGMENTS_PER_CHUNK);
+            out.insert(out.end(), chunks[c]->data, chunks[c]->data + count);
+            remaining -= count;
+        }
+    }
+
+private:
+    void nextChunk()
+    {
+        if (cursor != nullptr)
+            ++currentChunk;
+
+        if (currentChunk == chunks.size())
+            chunks.push_back(pool->acquire());
+
+        cursor = chunks[currentChunk]->data;
+        limit = cursor + SEGMENTS_PER_CHUNK;
+    }
+
+    ChunkPool *pool;
+    std::vector<SegmentChunk *> chunks;
+    std::size_t currentChunk = 0;
+    LineSegment *cursor = nullptr;
+    LineSegment *limit = nullptr;
+};
+
 int edgeCorners[4][2] = {
     {0, 1}, {1, 2}, {2, 3}, {3, 0}};
 
@@ -59,7 +235,7 @@ int edgePairs[16][4] = {
 void marchSquare(float cell_x, float cell_y,
                  float values[4],
                  float isolevel,
-                 std::vector<LineSegment>& outSegments)
+                 SegmentArena& outSegments)
 {
 
     int caseIdx = 0;
@@ -96,6 +272,46 @@ void marchSquare(float cell_x, float cell_y,
     }
 }
 
+// Una llamada del benchmark: cada hilo vacía su arena y escribe ahí los segmentos de sus filas
+// Los segmentos quedan repartidos en las arenas, no se juntan en un vector
+// variant_suite compila este archivo y mide esta misma función
+void contourGrid(const ScalarField &scalarField, int gridWidth, int gridHeight, float isolevel,
+                 std::vector<std::unique_ptr<SegmentArena>> &threadSegments)
+{
+    #pragma omp parallel
+    {
+        int tid = omp_get_thread_num();
+
+        auto &mySegs = *threadSegments[tid];
+        mySegs.clear();
+
+        #pragma omp for nowait schedule(static)
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            float left_top_val = scalarField[y * gridWidth];
+            float left_bottom_val = scalarField[(y + 1) * gridWidth];
+
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                float right_top_val = scalarField[y * gridWidth + (x + 1)];
+                float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                marchSquare((float)x, (float)y, values, isolevel, mySegs);
+
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+    }
+}
+
 int main(int argc, char *argv[])
 {
     int gridResolution = 100;
@@ -109,7 +325,7 @@ int main(int argc, char *argv[])
 
     const float isolevel = 0.5f;
 
-    std::vector<float> scalarField(gridWidth * gridHeight);
+    ScalarField scalarField(gridWidth * gridHeight);
 
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 
@@ -121,49 +337,20 @@ int main(int argc, char *argv[])
         }
     }
 
-    for (int i = 0; i < 10; ++i) 
-    {
-        int numThreads = omp_get_max_threads();
-        std::vector<std::vector<LineSegment>> threadSegments(numThreads);
-
-        double startTime = omp_get_wtime();
+    int numThreads = omp_get_max_threads();
 
-        #pragma omp parallel
-        {
-            int tid = omp_get_thread_num();
+    // Las arenas viven fuera del loop para reutilizar sus bloques entre llamadas
+    ChunkPool chunkPool;
+    std::vector<std::unique_ptr<SegmentArena>> threadSegments;
+    for (int t = 0; t < numThreads; ++t)
+        threadSegments.emplace_back(new SegmentArena(&chunkPool));
 
-            auto &mySegs = threadSegments[tid];
-            
-            std::size_t totalCells   = std::size_t(gridHeight - 1) * (gridWidth - 1);
-            std::size_t maxPerThread = (totalCells + numThreads - 1) / numThreads;
-            
-            mySegs.reserve(maxPerThread * 2);
+    const int iterations = 10;
 
-            #pragma omp for nowait schedule(static)
-            for (int y = 0; y < gridHeight - 1; ++y)
-            {
-                float left_top_val = scalarField[y * gridWidth];
-                float left_bottom_val = scalarField[(y + 1) * gridWidth];
-
-                for (int x = 0; x < gridWidth - 1; ++x)
-                {
-                    float right_top_val = scalarField[y * gridWidth + (x + 1)];
-                    float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
-
-                    float values[4] = {
-                        left_top_val,
-                        right_top_val,
-                        right_bottom_val,
-                        left_bottom_val
-                    };
-
-                    marchSquare((float)x, (float)y, values, isolevel, mySegs);
-
-                    left_top_val = right_top_val;
-                    left_bottom_val = right_bottom_val;
-                }
-            }
-        }
+    for (int i = 0; i < iterations; ++i)
+    {
+        double startTime = omp_get_wtime();
+        contourGrid(scalarField, gridWidth, gridHeight, isolevel, threadSegments);
 
         double endTime = omp_get_wtime();
         double elapsedTimeMs = (endTime - startTime) * 1000.0;
@@ -171,5 +358,11 @@ int main(int argc, char *argv[])
         std::cout << elapsedTimeMs << " ms." << std::endl;
     }
 
+    std::size_t totalCells = std::size_t(gridHeight - 1) * (gridWidth - 1);
+
+    printMemoryReport("scalarField", fieldMemory);
+    printMemoryReport("threadSegments", segmentMemory, iterations);
+    printTotalMemoryReport(totalCells);
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,577 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <random>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <unistd.h>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// Una fila de celdas con el sliding window del checkpoint 5, entre las columnas de celdas [x0, x1)
+void marchRow(const float *scalarField, int gridWidth, int y, int x0, int x1, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[x0];
+    float left_bottom_val = bottom[x0];
+
+    for (int x = x0; x < x1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// Banda de K filas, igual que en row_band_kernel
+template <int K>
+void marchBand(const float *scalarField, int gridWidth, int y0, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *base = scalarField + std::size_t(y0) * gridWidth;
+
+    float prev[K + 1];
+    for (int r = 0; r <= K; ++r)
+        prev[r] = base[std::size_t(r) * gridWidth];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float col[K + 1];
+        for (int r = 0; r <= K; ++r)
+            col[r] = base[std::size_t(r) * gridWidth + (x + 1)];
+
+        for (int r = 0; r < K; ++r)
+        {
+            float values[4] = {
+                prev[r],
+                col[r],
+                col[r + 1],
+                prev[r + 1]
+            };
+
+            marchSquare((float)x, (float)(y0 + r), values, isolevel, out);
+        }
+
+        for (int r = 0; r <= K; ++r)
+            prev[r] = col[r];
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Kernels del espacio de búsqueda
+// Todos usan schedule(runtime), así el schedule y el chunk se eligen con omp_set_schedule
+//  - rows: una fila por iteración (checkpoint 5), param sin uso
+//  - bands: bandas de param filas (2, 4, 8 o 16)
+//  - tiles: bloques de param x param celdas sobre el campo row-major
+// ---------------------------------------------------------------------------
+enum class Kernel
+{
+    Rows,
+    Bands,
+    Tiles
+};
+
+const char *kernelName(Kernel kernel)
+{
+    switch (kernel)
+    {
+    case Kernel::Bands: return "bands";
+    case Kernel::Tiles: return "tiles";
+    default: return "rows";
+    }
+}
+
+Kernel parseKernel(const std::string &name)
+{
+    if (name == "bands")
+        return Kernel::Bands;
+    if (name == "tiles")
+        return Kernel::Tiles;
+    return Kernel::Rows;
+}
+
+template <int K>
+void bandLoop(const float *data, int gridWidth, int gridHeight, float isolevel, std::vector<LineSegment> &out)
+{
+    const int cellRows = gridHeight - 1;
+    const int fullBands = cellRows / K;
+
+    #pragma omp for nowait schedule(runtime)
+    for (int b = 0; b < fullBands; ++b)
+        marchBand<K>(data, gridWidth, b * K, isolevel, out);
+
+    #pragma omp for nowait schedule(runtime)
+    for (int y = fullBands * K; y < cellRows; ++y)
+        marchRow(data, gridWidth, y, 0, gridWidth - 1, isolevel, out);
+}
+
+std::vector<LineSegment> contourWith(Kernel kernel, int param, const std::vector<float> &scalarField,
+                                     int gridWidth, int gridHeight, float isolevel)
+{
+    const float *data = scalarField.data();
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        if (kernel == Kernel::Rows)
+        {
+            #pragma omp for nowait schedule(runtime)
+            for (int y = 0; y < gridHeight - 1; ++y)
+                marchRow(data, gridWidth, y, 0, gridWidth - 1, isolevel, privateSegments);
+        }
+        else if (kernel == Kernel::Bands)
+        {
+            switch (param)
+            {
+            case 2: bandLoop<2>(data, gridWidth, gridHeight, isolevel, privateSegments); break;
+            case 4: bandLoop<4>(data, gridWidth, gridHeight, isolevel, privateSegments); break;
+            case 16: bandLoop<16>(data, gridWidth, gridHeight, isolevel, privateSegments); break;
+            default: bandLoop<8>(data, gridWidth, gridHeight, isolevel, privateSegments); break;
+            }
+        }
+        else
+        {
+            const int tile = std::max(2, param);
+            const int tilesX = (gridWidth - 1 + tile - 1) / tile;
+            const int tilesY = (gridHeight - 1 + tile - 1) / tile;
+
+            #pragma omp for nowait schedule(runtime)
+            for (int t = 0; t < tilesX * tilesY; ++t)
+            {
+                const int x0 = (t % tilesX) * tile, y0 = (t / tilesX) * tile;
+                const int x1 = std::min(gridWidth - 1, x0 + tile), y1 = std::min(gridHeight - 1, y0 + tile);
+
+                for (int y = y0; y < y1; ++y)
+                    marchRow(data, gridWidth, y, x0, x1, isolevel, privateSegments);
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// ---------------------------------------------------------------------------
+// Configuración y perfil de tuning
+// El perfil es un archivo de texto con una línea por (host, tamaño de malla):
+//   host tamaño hilos kernel param schedule chunk ms
+// host es hostname:cores, así un mismo archivo sirve para varios tipos de nodo
+// ---------------------------------------------------------------------------
+struct TuningConfig
+{
+    int threads;
+    Kernel kernel;
+    int param;
+    omp_sched_t schedule;
+    int chunk; // 0 = chunk por defecto del schedule
+};
+
+const char *scheduleName(omp_sched_t schedule)
+{
+    switch (schedule)
+    {
+    case omp_sched_dynamic: return "dynamic";
+    case omp_sched_guided: return "guided";
+    default: return "static";
+    }
+}
+
+omp_sched_t parseSchedule(const std::string &name)
+{
+    if (name == "dynamic")
+        return omp_sched_dynamic;
+    if (name == "guided")
+        return omp_sched_guided;
+    return omp_sched_static;
+}
+
+std::string describe(const TuningConfig &config)
+{
+    std::ostringstream out;
+    out << config.threads << " hilos, " << kernelName(config.kernel);
+    if (config.kernel != Kernel::Rows)
+        out << " " << config.param;
+    out << ", schedule(" << scheduleName(config.schedule);
+    if (config.chunk > 0)
+        out << ", " << config.chunk;
+    out << ")";
+    return out.str();
+}
+
+// Lo que se corre hoy sin tuning: omp_get_max_threads() del arranque (antes de cualquier omp_set_num_threads)
+TuningConfig defaultConfig()
+{
+    static const int initialThreads = omp_get_max_threads();
+    return {initialThreads, Kernel::Rows, 0, omp_sched_static, 0};
+}
+
+void applyConfig(const TuningConfig &config)
+{
+    omp_set_num_threads(config.threads);
+    omp_set_schedule(config.schedule, config.chunk);
+}
+
+std::string hostKey()
+{
+    char name[256] = {};
+    if (gethostname(name, sizeof(name) - 1) != 0)
+        std::snprintf(name, sizeof(name), "desconocido");
+    return std::string(name) + ":" + std::to_string(omp_get_num_procs());
+}
+
+struct ProfileEntry
+{
+    std::string host;
+    int gridSize;
+    TuningConfig config;
+    double ms;
+};
+
+std::vector<ProfileEntry> loadProfile(const std::string &path)
+{
+    std::vector<ProfileEntry> entries;
+    std::ifstream file(path);
+    std::string line;
+
+    while (std::getline(file, line))
+    {
+        if (line.empty() || line[0] == '#')
+            continue;
+
+        std::istringstream in(line);
+        ProfileEntry entry;
+        std::string kernel, schedule;
+
+        if (in >> entry.host >> entry.gridSize >> entry.config.threads >> kernel >> entry.config.param >> schedule >> entry.config.chunk >> entry.ms)
+        {
+            entry.config.kernel = parseKernel(kernel);
+            entry.config.schedule = parseSchedule(schedule);
+            entries.push_back(entry);
+        }
+    }
+
+    return entries;
+}
+
+void saveProfile(const std::string &path, const std::vector<ProfileEntry> &entries)
+{
+    std::ofstream file(path);
+    file << "# host tamaño hilos kernel param schedule chunk ms\n";
+
+    for (const ProfileEntry &entry : entries)
+    {
+        file << entry.host << " " << entry.gridSize << " " << entry.config.threads << " " << kernelName(entry.config.kernel)
+             << " " << entry.config.param << " " << scheduleName(entry.config.schedule) << " " << entry.config.chunk
+             << " " << entry.ms << "\n";
+    }
+}
+
+// La entrada de este host con el tamaño más cercano en escala logarítmica
+const ProfileEntry *lookup(const std::vector<ProfileEntry> &entries, const std::string &host, int gridSize)
+{
+    const ProfileEntry *best = nullptr;
+    double bestDistance = 0.0;
+
+    for (const ProfileEntry &entry : entries)
+    {
+        if (entry.host != host)
+            continue;
+
+        double distance = std::fabs(std::log2(double(entry.gridSize) / gridSize));
+        if (best == nullptr || distance < bestDistance)
+        {
+            best = &entry;
+            bestDistance = distance;
+        }
+    }
+
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// Búsqueda
+// El espacio completo (hilos x kernel x schedule x chunk) es grande, así que se recorre por etapas,
+// fijando lo mejor de cada una: primero el kernel con todos los hilos, después schedule y chunk,
+// y al final la cantidad de hilos. Cada medición es el mínimo de TRIALS corridas, y una configuración
+// solo reemplaza a la mejor si gana por más de MIN_IMPROVEMENT, así el ruido no elige el perfil
+// ---------------------------------------------------------------------------
+const int TRIALS = 3;
+const double MIN_IMPROVEMENT = 0.03;
+
+std::vector<float> makeField(int gridWidth, int gridHeight)
+{
+    // El campo binario aleatorio de los benchmarks, con semilla fija
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    std::mt19937 rng(2024);
+    for (float &v : scalarField)
+        v = (float)(rng() % 2);
+    return scalarField;
+}
+
+double measure(const TuningConfig &config, const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    applyConfig(config);
+
+    double best = 1e30;
+    for (int i = 0; i < TRIALS; ++i)
+    {
+        double startTime = omp_get_wtime();
+        contourWith(config.kernel, config.param, scalarField, gridWidth, gridHeight, isolevel);
+        best = std::min(best, (omp_get_wtime() - startTime) * 1000.0);
+    }
+    return best;
+}
+
+std::vector<int> threadCandidates()
+{
+    const int cores = std::max(omp_get_num_procs(), defaultConfig().threads);
+    std::vector<int> counts;
+
+    for (int t = 1; t < cores; t *= 2)
+        counts.push_back(t);
+
+    // Entre la mitad y el total también se prueban pasos intermedios, ahí suele estar el óptimo
+    for (int t = std::max(1, cores / 2) + std::max(1, cores / 8); t < cores; t += std::max(1, cores / 8))
+        counts.push_back(t);
+
+    counts.push_back(cores);
+    std::sort(counts.begin(), counts.end());
+    counts.erase(std::unique(counts.begin(), counts.end()), counts.end());
+    return counts;
+}
+
+ProfileEntry tune(int gridSize, const std::string &host)
+{
+    const int gridWidth = gridSize, gridHeight = gridSize;
+    const float isolevel = 0.5f;
+    std::vector<float> scalarField = makeField(gridWidth, gridHeight);
+
+    TuningConfig best = defaultConfig();
+    double bestMs = measure(best, scalarField, gridWidth, gridHeight, isolevel);
+    const double defaultMs = bestMs;
+    int evaluated = 1;
+
+    auto tryConfig = [&](const TuningConfig &candidate) {
+        double ms = measure(candidate, scalarField, gridWidth, gridHeight, isolevel);
+        ++evaluated;
+        if (ms < bestMs * (1.0 - MIN_IMPROVEMENT))
+        {
+            best = candidate;
+            bestMs = ms;
+        }
+    };
+
+    // Etapa 1: kernel y su parámetro
+    const TuningConfig base = best;
+    for (int k : {2, 4, 8, 16})
+        tryConfig({base.threads, Kernel::Bands, k, base.schedule, base.chunk});
+    for (int t : {32, 64, 128, 256})
+        tryConfig({base.threads, Kernel::Tiles, t, base.schedule, base.chunk});
+
+    // Etapa 2: schedule y chunk
+    const TuningConfig withKernel = best;
+    for (omp_sched_t schedule : {omp_sched_static, omp_sched_dynamic, omp_sched_guided})
+        for (int chunk : {0, 1, 4, 16, 64})
+            if (schedule != withKernel.schedule || chunk != withKernel.chunk)
+                tryConfig({withKernel.threads, withKernel.kernel, withKernel.param, schedule, chunk});
+
+    // Etapa 3: cantidad de hilos
+    const TuningConfig withSchedule = best;
+    for (int threads : threadCandidates())
+        if (threads != withSchedule.threads)
+            tryConfig({threads, withSchedule.kernel, withSchedule.param, withSchedule.schedule, withSchedule.chunk});
+
+    std::cout << "Malla " << gridSize << "x" << gridSize << ": " << evaluated << " configuraciones, mejor " << describe(best)
+              << " con " << bestMs << " ms (por defecto " << defaultMs << " ms)." << std::endl;
+
+    return {host, gridSize, best, bestMs};
+}
+
+int main(int argc, char *argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "run";
+    std::string profilePath = argc > 2 && argv[2][0] != '\0' ? argv[2] : "tuning_profile.txt";
+    const std::string host = hostKey();
+
+    // ./march tune [perfil] [tamaños...]: mide el espacio de búsqueda y guarda el perfil
+    // ./march run [perfil] [tamaño_malla]: busca la mejor configuración en el perfil y la compara con la de siempre
+    if (mode == "tune")
+    {
+        std::vector<int> sizes;
+        for (int i = 3; i < argc; ++i)
+            sizes.push_back(std::stoi(argv[i]));
+        if (sizes.empty())
+            sizes = {500, 1000, 2000, 4000};
+
+        std::cout << "\nTuning en " << host << ", perfil '" << profilePath << "'" << std::endl;
+
+        // Se reemplazan solo las entradas de este host con los mismos tamaños
+        std::vector<ProfileEntry> entries = loadProfile(profilePath);
+        for (int size : sizes)
+        {
+            ProfileEntry entry = tune(size, host);
+            entries.erase(std::remove_if(entries.begin(), entries.end(),
+                                         [&](const ProfileEntry &e) { return e.host == host && e.gridSize == size; }),
+                          entries.end());
+            entries.push_back(entry);
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const ProfileEntry &a, const ProfileEntry &b) {
+            return a.host != b.host ? a.host < b.host : a.gridSize < b.gridSize;
+        });
+        saveProfile(profilePath, entries);
+        return 0;
+    }
+
+    int gridResolution = argc > 3 ? std::stoi(argv[3]) : 1000;
+    const int gridWidth = gridResolution, gridHeight = gridResolution;
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    std::vector<ProfileEntry> entries = loadProfile(profilePath);
+    const ProfileEntry *entry = lookup(entries, host, gridResolution);
+
+    TuningConfig tuned = defaultConfig();
+    if (entry != nullptr)
+    {
+        tuned = entry->config;
+        std::cout << "Perfil de " << host << " para " << entry->gridSize << "x" << entry->gridSize << ": " << describe(tuned) << std::endl;
+    }
+    else
+    {
+        std::cout << "No hay entrada para " << host << " en '" << profilePath << "', se usa la configuración por defecto." << std::endl;
+    }
+
+    std::vector<float> scalarField = makeField(gridWidth, gridHeight);
+
+    for (const TuningConfig &config : {defaultConfig(), tuned})
+    {
+        applyConfig(config);
+
+        for (int i = 0; i < 3; ++i)
+        {
+            double startTime = omp_get_wtime();
+            std::size_t segments = contourWith(config.kernel, config.param, scalarField, gridWidth, gridHeight, isolevel).size();
+            double endTime = omp_get_wtime();
+
+            std::cout << describe(config) << ": marching squares tomó " << (endTime - startTime) * 1000.0 << " ms ("
+                      << segments << " segmentos)." << std::endl;
+        }
+    }
+
+    return 0;
+}
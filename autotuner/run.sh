@@ -0,0 +1,27 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="march"
+PROFILE="${2:-tuning_profile.txt}"
+
+if [ -n "$4" ]; then
+  export OMP_NUM_THREADS=$4
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17
+echo "Compilación exitosa. Ejecutable creado: $EXECUTABLE_NAME"
+echo ""
+
+# Sin perfil (o con "tune" como tercer argumento) se hace el tuning primero
+if [ ! -f "$PROFILE" ] || [ "$3" = "tune" ]; then
+  echo "Haciendo el tuning de este host..."
+  ./"$EXECUTABLE_NAME" tune "$PROFILE"
+  echo ""
+fi
+
+echo "Corriendo el ejecutable..."
+./"$EXECUTABLE_NAME" run "$PROFILE" "$1"
+echo ""
+
+echo "Proceso completado."
@@ -0,0 +1,341 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <random>
+#include <iostream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// Una fila de celdas con el sliding window del checkpoint 5
+void marchRow(const float *scalarField, int gridWidth, int y, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// API por lotes
+// Cada campo trae su tamaño y sus isovalues. Todos los campos se parten en bloques de filas de
+// ~CELLS_PER_ITEM celdas y los bloques de todos los campos se reparten en una sola región paralela,
+// así un campo de 256x256 no paga un fork/join entero y los hilos no esperan al final de cada campo.
+// ---------------------------------------------------------------------------
+struct FieldView
+{
+    const float *data;
+    int width, height;
+    const float *isolevels;
+    int numIsolevels;
+};
+
+// Los segmentos del campo f son segments[fieldOffsets[f], fieldOffsets[f + 1])
+// Dentro de cada campo quedan en orden de isovalue y fila, sin importar el número de hilos
+struct BatchResult
+{
+    std::vector<LineSegment> segments;
+    std::vector<std::size_t> fieldOffsets;
+
+    const LineSegment *fieldBegin(int f) const { return segments.data() + fieldOffsets[f]; }
+    std::size_t fieldCount(int f) const { return fieldOffsets[f + 1] - fieldOffsets[f]; }
+};
+
+const std::size_t CELLS_PER_ITEM = std::size_t(1) << 16;
+
+struct WorkItem
+{
+    int field;
+    int isolevel;
+    int rowBegin, rowEnd;
+};
+
+std::vector<WorkItem> planBatch(const std::vector<FieldView> &fields)
+{
+    std::vector<WorkItem> items;
+
+    for (int f = 0; f < (int)fields.size(); ++f)
+    {
+        const FieldView &field = fields[f];
+        if (field.width < 2 || field.height < 2)
+            continue;
+
+        const int cellRows = field.height - 1;
+        const int rowsPerItem = (int)std::max<std::size_t>(1, CELLS_PER_ITEM / (field.width - 1));
+
+        for (int level = 0; level < field.numIsolevels; ++level)
+            for (int y = 0; y < cellRows; y += rowsPerItem)
+                items.push_back({f, level, y, std::min(cellRows, y + rowsPerItem)});
+    }
+
+    return items;
+}
+
+BatchResult contourBatch(const std::vector<FieldView> &fields)
+{
+    const std::vector<WorkItem> items = planBatch(fields);
+    const int numItems = (int)items.size();
+
+    // Un buffer por bloque: son chicos, crecen en caché y no hay que copiar un buffer enorme por hilo al duplicarlo
+    std::vector<std::vector<LineSegment>> itemSegments(numItems);
+    std::vector<std::size_t> itemOffsets(numItems + 1, 0);
+
+    BatchResult result;
+
+    #pragma omp parallel
+    {
+        // dynamic: los bloques de campos distintos no cuestan lo mismo
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < numItems; ++i)
+        {
+            const WorkItem &item = items[i];
+            const FieldView &field = fields[item.field];
+            const float isolevel = field.isolevels[item.isolevel];
+
+            for (int y = item.rowBegin; y < item.rowEnd; ++y)
+                marchRow(field.data, field.width, y, isolevel, itemSegments[i]);
+        }
+
+        // El omp for de arriba termina con barrera: ya se conocen todos los tamaños
+        // Los bloques están en orden campo -> isovalue -> fila, así el prefix sum agrupa por campo
+        #pragma omp single
+        {
+            for (int i = 0; i < numItems; ++i)
+                itemOffsets[i + 1] = itemOffsets[i] + itemSegments[i].size();
+
+            result.segments.resize(itemOffsets[numItems]);
+
+            result.fieldOffsets.assign(fields.size() + 1, 0);
+            for (int i = 0; i < numItems; ++i)
+                result.fieldOffsets[items[i].field + 1] += itemSegments[i].size();
+            for (std::size_t f = 0; f < fields.size(); ++f)
+                result.fieldOffsets[f + 1] += result.fieldOffsets[f];
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < numItems; ++i)
+        {
+            std::copy(itemSegments[i].begin(), itemSegments[i].end(), result.segments.begin() + itemOffsets[i]);
+            std::vector<LineSegment>().swap(itemSegments[i]);
+        }
+    }
+
+    return result;
+}
+
+// Lo que se hace hoy: una región paralela (fork/join) por campo y por isovalue
+std::vector<std::vector<LineSegment>> contourEach(const std::vector<FieldView> &fields)
+{
+    std::vector<std::vector<LineSegment>> results(fields.size());
+
+    for (std::size_t f = 0; f < fields.size(); ++f)
+    {
+        const FieldView &field = fields[f];
+
+        for (int level = 0; level < field.numIsolevels; ++level)
+        {
+            const float isolevel = field.isolevels[level];
+            std::vector<LineSegment> &allSegments = results[f];
+
+            #pragma omp parallel
+            {
+                std::vector<LineSegment> privateSegments;
+
+                #pragma omp for nowait
+                for (int y = 0; y < field.height - 1; ++y)
+                    marchRow(field.data, field.width, y, isolevel, privateSegments);
+
+                #pragma omp critical
+                allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+            }
+        }
+    }
+
+    return results;
+}
+
+int main(int argc, char *argv[])
+{
+    int numFields = 100;
+    int minSize = 256;
+    int maxSize = 1024;
+
+    // Primer argumento: cuántos campos
+    // Segundo y tercer argumento: tamaño mínimo y máximo de cada campo
+    if (argc > 1)
+        numFields = std::stoi(argv[1]);
+
+    if (argc > 2)
+        minSize = std::max(2, std::stoi(argv[2]));
+
+    if (argc > 3)
+        maxSize = std::max(minSize, std::stoi(argv[3]));
+
+    std::mt19937 rng(12345);
+    std::uniform_int_distribution<int> sizeDist(minSize, maxSize);
+
+    std::vector<std::vector<float>> storage(numFields);
+    std::vector<FieldView> fields(numFields);
+    const float isolevel = 0.5f;
+    std::size_t totalCells = 0;
+
+    for (int f = 0; f < numFields; ++f)
+    {
+        int width = sizeDist(rng), height = sizeDist(rng);
+        storage[f].resize(std::size_t(width) * height);
+
+        for (float &v : storage[f])
+            v = (float)(rng() % 2);
+
+        fields[f] = {storage[f].data(), width, height, &isolevel, 1};
+        totalCells += std::size_t(width - 1) * (height - 1);
+    }
+
+    // Una malla grande con la misma cantidad de celdas, como referencia de throughput
+    const int bigSize = (int)std::sqrt((double)totalCells) + 1;
+    std::vector<float> bigStorage(std::size_t(bigSize) * bigSize);
+    for (float &v : bigStorage)
+        v = (float)(rng() % 2);
+    std::vector<FieldView> bigField = {{bigStorage.data(), bigSize, bigSize, &isolevel, 1}};
+
+    std::cout << "\n" << numFields << " campos de " << minSize << " a " << maxSize << " por lado ("
+              << totalCells << " celdas), malla de referencia " << bigSize << "x" << bigSize << std::endl;
+
+    for (int i = 0; i < 5; ++i)
+    {
+        double startTime = omp_get_wtime();
+        std::vector<std::vector<LineSegment>> each = contourEach(fields);
+        double eachMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        startTime = omp_get_wtime();
+        BatchResult batch = contourBatch(fields);
+        double batchMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        startTime = omp_get_wtime();
+        std::vector<std::vector<LineSegment>> big = contourEach(bigField);
+        double bigMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        bool match = true;
+        for (int f = 0; f < numFields; ++f)
+            match = match && each[f].size() == batch.fieldCount(f);
+
+        std::cout << "Campo por campo: " << eachMs << " ms (" << totalCells / (eachMs * 1e3) << " Mceldas/s), lote: "
+                  << batchMs << " ms (" << totalCells / (batchMs * 1e3) << " Mceldas/s), malla grande: "
+                  << bigMs << " ms (" << (double)(bigSize - 1) * (bigSize - 1) / (bigMs * 1e3) << " Mceldas/s)"
+                  << (match ? "." : ", los segmentos por campo NO coinciden.") << std::endl;
+    }
+
+    return 0;
+}
@@ -21,11 +21,17 @@ struct LineSegment
 // Se usa solo para el linear interpolation
 float EPS = 1e-6f;
 
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 // Usamos linear interpolation
 // Calcula en qué parte del borde entre dos puntos cae el isovalue
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     // Por seguridad, en caso no haya diferencia grande entre los valores de ambos puntos
     // Ayuda a que no creemos bordes demasiado pequeños
@@ -113,6 +119,38 @@ std::vector<LineSegment> marchSquare(Point corners[4],
     return segs;
 }
 
+// Recorre la malla una vez por isovalue y junta los segmentos de todas las celdas
+// variant_suite compila este archivo y mide esta misma función
+std::vector<LineSegment> contourGrid(const std::vector<std::vector<float>> &scalarField, int gridWidth, int gridHeight,
+                                     const std::vector<float> &isolevels)
+{
+    std::vector<LineSegment> allSegments;
+
+    for (float isolevel : isolevels)
+    {
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                Point corners[4] = {
+                    {(float)x, (float)y},
+                    {(float)x + 1, (float)y},
+                    {(float)x + 1, (float)y + 1},
+                    {(float)x, (float)y + 1}};
+
+                float values[4] = {
+                    scalarField[y][x], scalarField[y][x + 1],
+                    scalarField[y + 1][x + 1], scalarField[y + 1][x]};
+
+                std::vector<LineSegment> cellSegments = marchSquare(corners, values, isolevel);
+                allSegments.insert(allSegments.end(), cellSegments.begin(), cellSegments.end());
+            }
+        }
+    }
+
+    return allSegments;
+}
+
 int main(int argc, char *argv[])
 {
     int gridResolution = 100;
@@ -154,30 +192,8 @@ int main(int argc, char *argv[])
         }
     }
 
-    std::vector<LineSegment> allSegments;
     auto startTime = std::chrono::high_resolution_clock::now();
-
-    for (float isolevel : isolevels)
-    {
-        for (int y = 0; y < gridHeight - 1; ++y)
-        {
-            for (int x = 0; x < gridWidth - 1; ++x)
-            {
-                Point corners[4] = {
-                    {(float)x, (float)y},
-                    {(float)x + 1, (float)y},
-                    {(float)x + 1, (float)y + 1},
-                    {(float)x, (float)y + 1}};
-
-                float values[4] = {
-                    scalarField[y][x], scalarField[y][x + 1],
-                    scalarField[y + 1][x + 1], scalarField[y + 1][x]};
-
-                std::vector<LineSegment> cellSegments = marchSquare(corners, values, isolevel);
-                allSegments.insert(allSegments.end(), cellSegments.begin(), cellSegments.end());
-            }
-        }
-    }
+    std::vector<LineSegment> allSegments = contourGrid(scalarField, gridWidth, gridHeight, isolevels);
 
     auto endTime = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> elapsedTime = endTime - startTime;
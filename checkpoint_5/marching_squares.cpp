@@ -26,11 +26,17 @@ struct LineSegment
 // Se usa solo para el linear interpolation
 float EPS = 1e-6f;
 
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 // Usamos linear interpolation
 // Calcula en qué parte del borde entre dos puntos cae el isovalue
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     // Por seguridad, en caso no haya diferencia grande entre los valores de ambos puntos
     // Ayuda a que no creemos bordes demasiado pequeños
@@ -119,41 +125,12 @@ void marchSquare(float cell_x, float cell_y,
     }
 }
 
-int main(int argc, char *argv[])
+// Malla linealizada con sliding window por fila, un vector privado por hilo
+// variant_suite compila este archivo y mide esta misma función
+std::vector<LineSegment> contourGrid(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                     float isolevel)
 {
-    int gridResolution = 100;
-
-    // Primer argumento será qué tamaño será nuestra grid
-    if (argc > 1)
-        gridResolution = std::stoi(argv[1]);
-
-    const int gridWidth = gridResolution;
-    const int gridHeight = gridResolution;
-    const std::string outputFilename = "lines.csv";
-
-    const float isolevel = 0.5f;
-
-    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
-
-    // Ahora ya no es una matriz (vector de vectores)
-    // Sino, lo hemos linealizado
-    // Se cambia un poco cómo accedemos a las coordenadas, pero no es un gran cambio
-    std::vector<float> scalarField(gridWidth * gridHeight);
-
-    std::srand(static_cast<unsigned int>(std::time(nullptr)));
-
-    // Ahora nuestra malla está compuesta por 0s y 1s
-    // Tomamos esta decisión para que no hayan muchas celdas vacías y estresemos más los recursos
-    for (int y = 0; y < gridHeight; ++y)
-    {
-        for (int x = 0; x < gridWidth; ++x)
-        {
-            scalarField[y * gridWidth + x] = std::rand() % 2;
-        }
-    }
-
     std::vector<LineSegment> allSegments;
-    double startTime = omp_get_wtime();
 
     #pragma omp parallel
     {
@@ -190,6 +167,45 @@ int main(int argc, char *argv[])
         allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
     }
 
+    return allSegments;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+
+    // Primer argumento será qué tamaño será nuestra grid
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const std::string outputFilename = "lines.csv";
+
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    // Ahora ya no es una matriz (vector de vectores)
+    // Sino, lo hemos linealizado
+    // Se cambia un poco cómo accedemos a las coordenadas, pero no es un gran cambio
+    std::vector<float> scalarField(gridWidth * gridHeight);
+
+    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+
+    // Ahora nuestra malla está compuesta por 0s y 1s
+    // Tomamos esta decisión para que no hayan muchas celdas vacías y estresemos más los recursos
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            scalarField[y * gridWidth + x] = std::rand() % 2;
+        }
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<LineSegment> allSegments = contourGrid(scalarField, gridWidth, gridHeight, isolevel);
+
     double endTime = omp_get_wtime();
     double elapsedTimeMs = (endTime - startTime) * 1000.0;
 
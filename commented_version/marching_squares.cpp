@@ -46,9 +46,16 @@ struct LineSegment
       ENTRE LOS ISOVALORES DE LOS DOS VÉRTICES ES MUY PEQUEÑA
 */
 float EPS = 1e-6f;
+
+// HOOK DE variant_suite PARA CONTAR LAS LLAMADAS A LERP; QUEDA VACÍO AL COMPILAR ESTA CARPETA SOLA
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     if (std::fabs(denom) < EPS)
         return p1;
@@ -187,6 +194,65 @@ void marchSquare(float cell_x, float cell_y,
     - LLAMA A MARCHSQUARE POR CADA UNA DE LAS CASILLAS DISPONIBLES
     - OBTENEMOS TODOS LOS SEGMENTOS DE LÍNEA DE LA ISOCURVA RESULTANTE
 */
+// RECORRE LA MALLA EN PARALELO Y DEVUELVE TODOS LOS SEGMENTOS DE LÍNEA RESULTANTES
+// variant_suite COMPILA ESTE ARCHIVO Y MIDE ESTA MISMA FUNCIÓN
+std::vector<LineSegment> contourGrid(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                     float isolevel)
+{
+    // VECTOR DONDE SE GUARDARÁN TODOS LOS SEGMENTOS DE LÍNEA RESULTANTE
+    std::vector<LineSegment> allSegments;
+
+    // INICIO DE LA SECCIÓN PARALELA
+    #pragma omp parallel
+    {
+        // CADA THREAD DEFINIRÁ SU PROPIO VECTOR PARA SUS SEGMENTOS GENERADOS
+        std::vector<LineSegment> privateSegments;
+
+        // SE PARALELIZA EL FOR QUE ITERA LAS POSIBLES CASILLAS EN LA MALLA
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            // PRIMERO OBTENEMOS LOS VALORES EL LADO IZQUIERDO DE LA CASILLA
+            float left_top_val = scalarField[y * gridWidth];
+            float left_bottom_val = scalarField[(y + 1) * gridWidth];
+
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                // LUEGO OBTENEMOS LOS VALORES DEL LADO DERECHO DE LA CASILLA
+                float right_top_val = scalarField[y * gridWidth + (x + 1)];
+                float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                // LLAMAMOS A MARCHSQUARE AHORA QUE TENEMOS TODOS LOS DATOS
+                marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                /*
+                    PASANDO A LA SIGUIENTE CASILLA, AHORA LOS VALORES
+                    QUE ESTABAN EN LA DERECHA PASARÁN A LA IZQUIERDA.
+                
+                    ESTA ESTRATEGIA DE SLIDING WINDOW PERMITE REDUCIR EL NÚMERO DE ACCESOS
+                    A A LA MALLA ORIGINAL EN LA MITAD. EN LUGAR DE ACCEDER CUATRO VECES POR
+                    ITERACIÓN, AHORA SOLO SE ACCEDE DOS VECES.
+                */
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+
+        // AHORA, SE NECESITA UNA SECCIÓN CRÍTICA PARA AÑADIR LOS SEGMENTOS PRIVADOS AL GLOBAL
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
 int main(int argc, char *argv[])
 {
     int gridResolution = 100;
@@ -241,58 +307,8 @@ int main(int argc, char *argv[])
         MINIMIZAMOS LAS CASILLAS EN DONDE NO SE GENERA SEGMENTO ALGUNO.
     */
 
-    // VECTOR DONDE SE GUARDARÁN TODOS LOS SEGMENTOS DE LÍNEA RESULTANTE
-    std::vector<LineSegment> allSegments;
-
     double startTime = omp_get_wtime();
-
-    // INICIO DE LA SECCIÓN PARALELA
-    #pragma omp parallel
-    {
-        // CADA THREAD DEFINIRÁ SU PROPIO VECTOR PARA SUS SEGMENTOS GENERADOS
-        std::vector<LineSegment> privateSegments;
-
-        // SE PARALELIZA EL FOR QUE ITERA LAS POSIBLES CASILLAS EN LA MALLA
-        #pragma omp for nowait
-        for (int y = 0; y < gridHeight - 1; ++y)
-        {
-            // PRIMERO OBTENEMOS LOS VALORES EL LADO IZQUIERDO DE LA CASILLA
-            float left_top_val = scalarField[y * gridWidth];
-            float left_bottom_val = scalarField[(y + 1) * gridWidth];
-
-            for (int x = 0; x < gridWidth - 1; ++x)
-            {
-                // LUEGO OBTENEMOS LOS VALORES DEL LADO DERECHO DE LA CASILLA
-                float right_top_val = scalarField[y * gridWidth + (x + 1)];
-                float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
-
-                float values[4] = {
-                    left_top_val,
-                    right_top_val,
-                    right_bottom_val,
-                    left_bottom_val
-                };
-
-                // LLAMAMOS A MARCHSQUARE AHORA QUE TENEMOS TODOS LOS DATOS
-                marchSquare((float)x, (float)y, values, isolevel, privateSegments);
-
-                /*
-                    PASANDO A LA SIGUIENTE CASILLA, AHORA LOS VALORES
-                    QUE ESTABAN EN LA DERECHA PASARÁN A LA IZQUIERDA.
-                
-                    ESTA ESTRATEGIA DE SLIDING WINDOW PERMITE REDUCIR EL NÚMERO DE ACCESOS
-                    A A LA MALLA ORIGINAL EN LA MITAD. EN LUGAR DE ACCEDER CUATRO VECES POR
-                    ITERACIÓN, AHORA SOLO SE ACCEDE DOS VECES.
-                */
-                left_top_val = right_top_val;
-                left_bottom_val = right_bottom_val;
-            }
-        }
-
-        // AHORA, SE NECESITA UNA SECCIÓN CRÍTICA PARA AÑADIR LOS SEGMENTOS PRIVADOS AL GLOBAL
-        #pragma omp critical
-        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
-    }
+    std::vector<LineSegment> allSegments = contourGrid(scalarField, gridWidth, gridHeight, isolevel);
 
     // TERMINAMOS DE MEDIR EL TIEMPO E IMPRIMIMOS RESULTADOS
     double endTime = omp_get_wtime();
@@ -0,0 +1,113 @@
+#ifndef MEMORY_COUNTER_H
+#define MEMORY_COUNTER_H
+
+#include <atomic>
+#include <cstddef>
+#include <iostream>
+#include <new>
+#include <sys/resource.h>
+
+// Instrumentación de memoria compartida por los benchmarks de optimized_results_compilation,
+// non_optimized_results_compilation y alternative_optimizations
+// Cada benchmark declara sus contadores por fase y los pasa como parámetro de CountingAllocator
+
+// Contador de memoria por fase: bytes vivos, pico y total reservado (incluye las copias al crecer)
+// No se reinicia entre iteraciones: el pico es el máximo de toda la corrida y lo reservado se acumula
+struct MemoryCounter
+{
+    std::atomic<long long> current{0};
+    std::atomic<long long> peak{0};
+    std::atomic<long long> allocated{0};
+    std::atomic<long long> allocations{0};
+
+    void add(long long bytes)
+    {
+        long long now = current.fetch_add(bytes) + bytes;
+        long long prev = peak.load();
+        while (now > prev && !peak.compare_exchange_weak(prev, now))
+        {
+        }
+        allocated += bytes;
+        ++allocations;
+    }
+
+    void sub(long long bytes) { current -= bytes; }
+};
+
+// Suma de todas las fases
+inline MemoryCounter totalMemory;
+
+// Allocator que cuenta los bytes en su fase y en el total
+template <typename T, MemoryCounter *Counter>
+struct CountingAllocator
+{
+    using value_type = T;
+
+    template <typename U>
+    struct rebind
+    {
+        using other = CountingAllocator<U, Counter>;
+    };
+
+    CountingAllocator() = default;
+
+    template <typename U>
+    CountingAllocator(const CountingAllocator<U, Counter> &) {}
+
+    T *allocate(std::size_t n)
+    {
+        long long bytes = (long long)(n * sizeof(T));
+        Counter->add(bytes);
+        totalMemory.add(bytes);
+        return static_cast<T *>(::operator new(n * sizeof(T)));
+    }
+
+    void deallocate(T *p, std::size_t n)
+    {
+        long long bytes = (long long)(n * sizeof(T));
+        Counter->sub(bytes);
+        totalMemory.sub(bytes);
+        ::operator delete(p);
+    }
+};
+
+template <typename T, typename U, MemoryCounter *C>
+bool operator==(const CountingAllocator<T, C> &, const CountingAllocator<U, C> &) { return true; }
+
+template <typename T, typename U, MemoryCounter *C>
+bool operator!=(const CountingAllocator<T, C> &, const CountingAllocator<U, C> &) { return false; }
+
+// Pico de memoria residente del proceso (ru_maxrss está en KB en Linux y en bytes en macOS)
+inline double peakRssMB()
+{
+    struct rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+    return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+    return usage.ru_maxrss / 1024.0;
+#endif
+}
+
+inline double toMB(long long bytes)
+{
+    return bytes / (1024.0 * 1024.0);
+}
+
+// iterations: entre cuántas iteraciones se reparte lo reservado (1 para lo que se reserva una sola vez)
+inline void printMemoryReport(const char *label, const MemoryCounter &counter, int iterations = 1)
+{
+    std::cout << "Memoria " << label << ": pico " << toMB(counter.peak) << " MB, reservado "
+              << toMB(counter.allocated) / iterations << " MB en " << double(counter.allocations) / iterations
+              << " reservas" << (iterations > 1 ? " por iteración." : ".") << std::endl;
+}
+
+// Pico de todas las fases juntas en toda la corrida, por celda, y el pico RSS del proceso
+inline void printTotalMemoryReport(std::size_t totalCells)
+{
+    std::cout << "Memoria total pico: " << toMB(totalMemory.peak) << " MB ("
+              << (double)totalMemory.peak / totalCells << " bytes por celda)." << std::endl;
+    std::cout << "Pico RSS: " << peakRssMB() << " MB." << std::endl;
+}
+
+#endif
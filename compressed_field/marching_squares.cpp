@@ -0,0 +1,466 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Codec
+// Cada chunk elige el más pequeño de:
+//  - CODEC_BITMASK: si el chunk solo tiene 2 valores distintos (máscaras binarias), 1 bit por muestra
+//  - CODEC_SHUFFLE_RLE: separa los floats en 4 planos de bytes y aplica RLE (PackBits) a cada plano,
+//    en campos suaves los bytes de signo/exponente se repiten mucho
+//  - CODEC_RAW: los floats tal cual, si lo anterior no ayuda
+// ---------------------------------------------------------------------------
+enum Codec : uint8_t
+{
+    CODEC_RAW = 0,
+    CODEC_BITMASK = 1,
+    CODEC_SHUFFLE_RLE = 2
+};
+
+// PackBits: control n < 128 -> n + 1 bytes literales, n >= 128 -> el siguiente byte se repite n - 125 veces
+void rleEncode(const uint8_t *in, std::size_t size, std::vector<uint8_t> &out)
+{
+    std::size_t i = 0;
+
+    while (i < size)
+    {
+        std::size_t run = 1;
+        while (i + run < size && run < 130 && in[i + run] == in[i])
+            ++run;
+
+        if (run >= 3)
+        {
+            out.push_back((uint8_t)(run + 125));
+            out.push_back(in[i]);
+            i += run;
+            continue;
+        }
+
+        // Literales hasta encontrar una racha de 3 o llegar a 128
+        std::size_t start = i, count = 0;
+        while (i < size && count < 128)
+        {
+            if (i + 2 < size && in[i] == in[i + 1] && in[i] == in[i + 2])
+                break;
+            ++i;
+            ++count;
+        }
+
+        out.push_back((uint8_t)(count - 1));
+        out.insert(out.end(), in + start, in + start + count);
+    }
+}
+
+const uint8_t *rleDecode(const uint8_t *in, uint8_t *out, std::size_t size)
+{
+    std::size_t written = 0;
+
+    while (written < size)
+    {
+        uint8_t control = *in++;
+
+        if (control < 128)
+        {
+            std::size_t count = control + 1;
+            std::memcpy(out + written, in, count);
+            in += count;
+            written += count;
+        }
+        else
+        {
+            std::size_t count = control - 125;
+            std::memset(out + written, *in++, count);
+            written += count;
+        }
+    }
+
+    return in;
+}
+
+struct CompressedChunk
+{
+    Codec codec;
+    int firstRow, rows;
+    std::vector<uint8_t> bytes;
+};
+
+// La malla se guarda en bandas de bandRows filas de celdas
+// Cada banda incluye también la primera fila de la siguiente, así se puede hacer marching sola
+struct CompressedField
+{
+    int width, height;
+    int bandRows;
+    std::vector<CompressedChunk> chunks;
+
+    std::size_t compressedBytes() const
+    {
+        std::size_t total = 0;
+        for (const CompressedChunk &chunk : chunks)
+            total += chunk.bytes.size();
+        return total;
+    }
+};
+
+void compressChunk(const float *values, std::size_t count, CompressedChunk &chunk)
+{
+    const uint8_t *raw = reinterpret_cast<const uint8_t *>(values);
+    chunk.bytes.clear();
+
+    // ¿Máscara binaria?
+    float low = values[0], high = values[0];
+    bool binary = true;
+    for (std::size_t i = 0; i < count && binary; ++i)
+    {
+        if (values[i] == low || values[i] == high)
+            continue;
+
+        if (low == high)
+            high = values[i];
+        else
+            binary = false;
+    }
+
+    if (binary)
+    {
+        chunk.codec = CODEC_BITMASK;
+        chunk.bytes.resize(2 * sizeof(float) + (count + 7) / 8, 0);
+        std::memcpy(chunk.bytes.data(), &low, sizeof(float));
+        std::memcpy(chunk.bytes.data() + sizeof(float), &high, sizeof(float));
+
+        uint8_t *bits = chunk.bytes.data() + 2 * sizeof(float);
+        for (std::size_t i = 0; i < count; ++i)
+            if (values[i] != low)
+                bits[i >> 3] |= (uint8_t)(1u << (i & 7));
+
+        return;
+    }
+
+    // Byte shuffle + RLE por plano
+    std::vector<uint8_t> plane(count);
+    for (int b = 0; b < 4; ++b)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+            plane[i] = raw[4 * i + b];
+
+        rleEncode(plane.data(), count, chunk.bytes);
+    }
+
+    if (chunk.bytes.size() < count * sizeof(float))
+    {
+        chunk.codec = CODEC_SHUFFLE_RLE;
+        return;
+    }
+
+    chunk.codec = CODEC_RAW;
+    chunk.bytes.assign(raw, raw + count * sizeof(float));
+}
+
+// Descomprime en out (count floats); plane es un buffer auxiliar del hilo
+void decompressChunk(const CompressedChunk &chunk, std::size_t count, float *out, std::vector<uint8_t> &plane)
+{
+    const uint8_t *in = chunk.bytes.data();
+
+    switch (chunk.codec)
+    {
+    case CODEC_RAW:
+        std::memcpy(out, in, count * sizeof(float));
+        break;
+
+    case CODEC_BITMASK:
+    {
+        float low, high;
+        std::memcpy(&low, in, sizeof(float));
+        std::memcpy(&high, in + sizeof(float), sizeof(float));
+
+        const uint8_t *bits = in + 2 * sizeof(float);
+        for (std::size_t i = 0; i < count; ++i)
+            out[i] = (bits[i >> 3] >> (i & 7)) & 1 ? high : low;
+        break;
+    }
+
+    case CODEC_SHUFFLE_RLE:
+    {
+        uint8_t *raw = reinterpret_cast<uint8_t *>(out);
+        plane.resize(count);
+
+        for (int b = 0; b < 4; ++b)
+        {
+            in = rleDecode(in, plane.data(), count);
+            for (std::size_t i = 0; i < count; ++i)
+                raw[4 * i + b] = plane[i];
+        }
+        break;
+    }
+    }
+}
+
+// Construye el campo comprimido banda por banda: rowGenerator(y, row) llena una fila
+// La malla completa nunca existe descomprimida, ni siquiera al generarla
+template <typename RowGenerator>
+CompressedField compressField(int gridWidth, int gridHeight, int bandRows, RowGenerator rowGenerator)
+{
+    CompressedField field;
+    field.width = gridWidth;
+    field.height = gridHeight;
+    field.bandRows = bandRows;
+
+    const int bandCount = (gridHeight - 1 + bandRows - 1) / bandRows;
+    field.chunks.resize(bandCount);
+
+    #pragma omp parallel
+    {
+        std::vector<float> scratch;
+
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < bandCount; ++b)
+        {
+            CompressedChunk &chunk = field.chunks[b];
+            chunk.firstRow = b * bandRows;
+            chunk.rows = std::min(chunk.firstRow + bandRows, gridHeight - 1) - chunk.firstRow + 1;
+
+            scratch.resize(std::size_t(chunk.rows) * gridWidth);
+            for (int r = 0; r < chunk.rows; ++r)
+                rowGenerator(chunk.firstRow + r, &scratch[std::size_t(r) * gridWidth]);
+
+            compressChunk(scratch.data(), scratch.size(), chunk);
+        }
+    }
+
+    return field;
+}
+
+// Cada hilo descomprime su banda en un buffer pequeño (cabe en caché) y hace marching de inmediato
+std::vector<LineSegment> contourCompressed(const CompressedField &field, float isolevel)
+{
+    const int gridWidth = field.width;
+    const int bandCount = (int)field.chunks.size();
+
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+        std::vector<float> band;
+        std::vector<uint8_t> plane;
+
+        #pragma omp for nowait schedule(dynamic)
+        for (int b = 0; b < bandCount; ++b)
+        {
+            const CompressedChunk &chunk = field.chunks[b];
+
+            band.resize(std::size_t(chunk.rows) * gridWidth);
+            decompressChunk(chunk, band.size(), band.data(), plane);
+
+            for (int r = 0; r + 1 < chunk.rows; ++r)
+            {
+                const float *top = &band[std::size_t(r) * gridWidth];
+                const float *bottom = top + gridWidth;
+                const int y = chunk.firstRow + r;
+
+                float left_top_val = top[0];
+                float left_bottom_val = bottom[0];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = top[x + 1];
+                    float right_bottom_val = bottom[x + 1];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// Hash para generar valores aleatorios por posición sin estado compartido entre hilos
+uint32_t hashCell(uint32_t seed, uint32_t x, uint32_t y)
+{
+    uint32_t h = seed ^ (x * 0x9E3779B1u) ^ (y * 0x85EBCA77u);
+    h ^= h >> 16;
+    h *= 0x7FEB352Du;
+    h ^= h >> 15;
+    h *= 0x846CA68Bu;
+    h ^= h >> 16;
+    return h;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+    int bandRows = 8;
+    std::string fieldType = "binary";
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: filas por banda comprimida
+    // Tercer argumento: tipo de campo, "binary" (0s y 1s aleatorios) o "smooth"
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        bandRows = std::stoi(argv[2]);
+
+    if (argc > 3)
+        fieldType = argv[3];
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    const float isolevel = fieldType == "smooth" ? 0.0f : 0.5f;
+    const uint32_t seed = static_cast<uint32_t>(std::time(nullptr));
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    auto rowGenerator = [&](int y, float *row)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            if (fieldType == "smooth")
+            {
+                float u = (float)x / gridWidth, v = (float)y / gridHeight;
+                row[x] = std::sin(12.0f * u) * std::cos(9.0f * v) + 0.5f * std::sin(31.0f * (u + v));
+            }
+            else
+            {
+                row[x] = (float)(hashCell(seed, x, y) & 1);
+            }
+        }
+    };
+
+    double startTime = omp_get_wtime();
+    CompressedField field = compressField(gridWidth, gridHeight, bandRows, rowGenerator);
+    double endTime = omp_get_wtime();
+
+    std::size_t rawBytes = std::size_t(gridWidth) * gridHeight * sizeof(float);
+    std::size_t compressedBytes = field.compressedBytes();
+
+    std::cout << "Compresión tomó " << (endTime - startTime) * 1000.0 << " ms: "
+              << compressedBytes / (1024.0 * 1024.0) << " MB de " << rawBytes / (1024.0 * 1024.0)
+              << " MB (" << (double)rawBytes / compressedBytes << "x)." << std::endl;
+
+    startTime = omp_get_wtime();
+    std::vector<LineSegment> allSegments = contourCompressed(field, isolevel);
+    endTime = omp_get_wtime();
+
+    std::cout << "Marching squares sobre el campo comprimido tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+    std::cout << "Se generó " << allSegments.size() << " segmentos de línea." << std::endl;
+
+    return 0;
+}
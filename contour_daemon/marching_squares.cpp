@@ -0,0 +1,953 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <new>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+static_assert(sizeof(LineSegment) == 4 * sizeof(float), "LineSegment viaja en memoria compartida como 4 floats");
+
+// Una fila de celdas con el sliding window del checkpoint 5
+void marchRow(const float *scalarField, int gridWidth, int y, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Protocolo
+// Socket Unix SOCK_SEQPACKET: cada mensaje llega entero y el descriptor viaja con SCM_RIGHTS.
+// El cliente manda el campo en un memfd y el servidor responde con otro memfd que tiene:
+//   ResultHeader | levelOffsets (int64, numIsolevels + 1) | segmentos
+// Ninguno de los dos serializa nada, ambos mapean la misma memoria
+// ---------------------------------------------------------------------------
+const uint32_t REQUEST_MAGIC = 0x4d534451; // "MSDQ"
+const int MAX_ISOLEVELS = 64;
+
+// Tope de celdas x isovalues por petición, para que una sola no pueda pedir toda la memoria del servidor
+const std::size_t MAX_REQUEST_CELLS = std::size_t(1) << 28;
+
+// Sellos que tiene que traer el memfd del campo: sin ellos el cliente podría achicarlo (SIGBUS en el servidor)
+// o cambiarlo mientras se recorre
+const int REQUIRED_FIELD_SEALS = F_SEAL_SHRINK | F_SEAL_WRITE;
+
+enum RequestKind : int32_t
+{
+    REQUEST_CONTOUR = 1,
+    REQUEST_SHUTDOWN = 2
+};
+
+enum ResponseStatus : int32_t
+{
+    STATUS_OK = 0,
+    STATUS_BAD_REQUEST = -1,
+    STATUS_NO_MEMORY = -2
+};
+
+struct ContourRequest
+{
+    uint32_t magic;
+    int32_t kind;
+    int32_t width, height;
+    int32_t numIsolevels;
+    int32_t reserved;
+    float isolevels[MAX_ISOLEVELS];
+};
+
+struct ContourResponse
+{
+    int32_t status;
+    int32_t numIsolevels;
+    uint64_t segmentCount;
+    uint64_t resultBytes;
+};
+
+struct ResultHeader
+{
+    uint64_t segmentCount;
+    uint64_t numIsolevels;
+};
+
+std::size_t resultBytes(std::size_t numIsolevels, std::size_t segmentCount)
+{
+    return sizeof(ResultHeader) + (numIsolevels + 1) * sizeof(int64_t) + segmentCount * sizeof(LineSegment);
+}
+
+// Manda un mensaje y, si fd >= 0, el descriptor junto con él
+bool sendMessage(int socketFd, const void *message, std::size_t size, int fd)
+{
+    iovec io = {const_cast<void *>(message), size};
+    msghdr header = {};
+    header.msg_iov = &io;
+    header.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    if (fd >= 0)
+    {
+        header.msg_control = control;
+        header.msg_controllen = sizeof(control);
+
+        cmsghdr *cmsg = CMSG_FIRSTHDR(&header);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type = SCM_RIGHTS;
+        cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+        std::memcpy(CMSG_DATA(cmsg), &fd, sizeof(int));
+    }
+
+    ssize_t sent;
+    do
+        sent = sendmsg(socketFd, &header, MSG_NOSIGNAL);
+    while (sent < 0 && errno == EINTR);
+
+    return sent == (ssize_t)size;
+}
+
+// Devuelve los bytes recibidos (0 si el otro lado cerró); fd queda en -1 si no vino ningún descriptor.
+// Si el mensaje venía más largo que size se devuelve su largo real, así el que llama lo rechaza por tamaño
+ssize_t receiveMessage(int socketFd, void *message, std::size_t size, int &fd)
+{
+    fd = -1;
+
+    iovec io = {message, size};
+    msghdr header = {};
+    header.msg_iov = &io;
+    header.msg_iovlen = 1;
+
+    alignas(cmsghdr) char control[CMSG_SPACE(sizeof(int))] = {};
+    header.msg_control = control;
+    header.msg_controllen = sizeof(control);
+
+    ssize_t received;
+    do
+        received = recvmsg(socketFd, &header, MSG_CMSG_CLOEXEC | MSG_TRUNC);
+    while (received < 0 && errno == EINTR);
+
+    if (received <= 0)
+        return received;
+
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&header); cmsg != nullptr; cmsg = CMSG_NXTHDR(&header, cmsg))
+    {
+        if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS)
+            std::memcpy(&fd, CMSG_DATA(cmsg), sizeof(int));
+    }
+
+    // Un mensaje truncado no es del protocolo
+    if (header.msg_flags & (MSG_TRUNC | MSG_CTRUNC))
+    {
+        if (fd >= 0)
+            close(fd);
+        fd = -1;
+    }
+
+    return received;
+}
+
+// Región mapeada, se desmapea en el destructor
+class MappedRegion
+{
+public:
+    MappedRegion() = default;
+    MappedRegion(void *address, std::size_t size) : address_(address), size_(size) {}
+    MappedRegion(const MappedRegion &) = delete;
+    MappedRegion &operator=(const MappedRegion &) = delete;
+
+    MappedRegion(MappedRegion &&other) noexcept : address_(other.address_), size_(other.size_)
+    {
+        other.address_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedRegion &operator=(MappedRegion &&other) noexcept
+    {
+        std::swap(address_, other.address_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~MappedRegion()
+    {
+        if (address_ != nullptr)
+            munmap(address_, size_);
+    }
+
+    static MappedRegion map(int fd, std::size_t size, bool writable)
+    {
+        if (size == 0)
+            return MappedRegion();
+
+        void *address = mmap(nullptr, size, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, fd, 0);
+        return address == MAP_FAILED ? MappedRegion() : MappedRegion(address, size);
+    }
+
+    unsigned char *data() const { return static_cast<unsigned char *>(address_); }
+    std::size_t size() const { return size_; }
+    explicit operator bool() const { return address_ != nullptr; }
+
+private:
+    void *address_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// memfd del tamaño pedido y mapeado para escribir; -1 si falla. Con sealable se le pueden poner sellos después
+int createSharedBuffer(const char *name, std::size_t size, MappedRegion &region, bool sealable = false)
+{
+    int fd = memfd_create(name, MFD_CLOEXEC | (sealable ? MFD_ALLOW_SEALING : 0));
+    if (fd < 0)
+        return -1;
+
+    if (ftruncate(fd, (off_t)size) != 0 || !(region = MappedRegion::map(fd, size, true)))
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+// Congela el memfd: sin achicar, agrandar ni escribir. F_SEAL_WRITE exige que no quede ningún mapeo escribible,
+// así que se desmapea region y se vuelve a mapear solo lectura
+bool sealReadOnly(int fd, MappedRegion &region)
+{
+    const std::size_t size = region.size();
+    region = MappedRegion();
+
+    if (fcntl(fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) != 0)
+        return false;
+
+    region = MappedRegion::map(fd, size, false);
+    return bool(region);
+}
+
+// ---------------------------------------------------------------------------
+// Servidor
+// El hilo principal atiende el socket con poll: acepta clientes, recibe peticiones y mapea el campo.
+// Las peticiones van a una cola; el hilo dispatcher saca todas las que haya y las resuelve en una sola
+// región paralela, como contourBatch de batched_contouring. Como siempre es el mismo hilo el que abre
+// las regiones, OpenMP reutiliza el mismo equipo de hilos entre lotes.
+// ---------------------------------------------------------------------------
+
+// El socket de un cliente se cierra cuando ya nadie lo usa: ni el hilo de poll ni una petición en la cola
+struct Connection
+{
+    int fd;
+    explicit Connection(int socketFd) : fd(socketFd) {}
+    ~Connection() { close(fd); }
+};
+
+struct Job
+{
+    std::shared_ptr<Connection> connection;
+    ContourRequest request;
+    MappedRegion field;
+};
+
+class JobQueue
+{
+public:
+    void push(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(std::move(job));
+        }
+        condition_.notify_one();
+    }
+
+    // Espera a que haya trabajo y se lleva hasta maxJobs; false cuando la cola está cerrada y vacía
+    bool popBatch(std::vector<Job> &batch, std::size_t maxJobs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        condition_.wait(lock, [&] { return closed_ || !jobs_.empty(); });
+
+        if (jobs_.empty())
+            return false;
+
+        while (!jobs_.empty() && batch.size() < maxJobs)
+        {
+            batch.push_back(std::move(jobs_.front()));
+            jobs_.pop_front();
+        }
+        return true;
+    }
+
+    void close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            closed_ = true;
+        }
+        condition_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<Job> jobs_;
+    bool closed_ = false;
+};
+
+const std::size_t MAX_BATCH = 64;
+const std::size_t CELLS_PER_ITEM = std::size_t(1) << 16;
+
+struct WorkItem
+{
+    int job;
+    int isolevel;
+    int rowBegin, rowEnd;
+};
+
+struct ServerStats
+{
+    std::size_t jobs = 0;
+    std::size_t batches = 0;
+    std::size_t largestBatch = 0;
+    double busyMs = 0.0;
+};
+
+// Resuelve un lote completo y responde a cada cliente con su memfd de resultado
+void serveBatch(std::vector<Job> &batch, ServerStats &stats)
+{
+    double startTime = omp_get_wtime();
+    const int numJobs = (int)batch.size();
+
+    // Igual que planBatch: bloques de filas de ~CELLS_PER_ITEM celdas en orden petición -> isovalue -> fila
+    std::vector<WorkItem> items;
+    for (int j = 0; j < numJobs; ++j)
+    {
+        const ContourRequest &request = batch[j].request;
+        const int cellRows = request.height - 1;
+        const int rowsPerItem = (int)std::max<std::size_t>(1, CELLS_PER_ITEM / (request.width - 1));
+
+        for (int level = 0; level < request.numIsolevels; ++level)
+            for (int y = 0; y < cellRows; y += rowsPerItem)
+                items.push_back({j, level, y, std::min(cellRows, y + rowsPerItem)});
+    }
+
+    const int numItems = (int)items.size();
+    std::vector<std::vector<LineSegment>> itemSegments(numItems);
+
+    // Dónde escribe cada bloque: el memfd de su petición más su offset dentro de él
+    std::vector<LineSegment *> itemDestinations(numItems, nullptr);
+    std::vector<MappedRegion> results(numJobs);
+    std::vector<int> resultFds(numJobs, -1);
+    std::vector<ContourResponse> responses(numJobs);
+
+    // Una excepción no puede salir de la región paralela: si un bloque se queda sin memoria se marca su
+    // petición y esa responde STATUS_NO_MEMORY, las demás del lote siguen
+    std::vector<unsigned char> jobFailed(numJobs, 0);
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < numItems; ++i)
+        {
+            const WorkItem &item = items[i];
+            const ContourRequest &request = batch[item.job].request;
+            const float *field = reinterpret_cast<const float *>(batch[item.job].field.data());
+
+            try
+            {
+                for (int y = item.rowBegin; y < item.rowEnd; ++y)
+                    marchRow(field, request.width, y, request.isolevels[item.isolevel], itemSegments[i]);
+            }
+            catch (const std::bad_alloc &)
+            {
+                #pragma omp atomic write
+                jobFailed[item.job] = 1;
+            }
+        }
+
+        // Ya se conocen todos los tamaños: un memfd por petición con los offsets por isovalue
+        #pragma omp single
+        {
+            int first = 0;
+            for (int j = 0; j < numJobs; ++j)
+            {
+                const int numIsolevels = batch[j].request.numIsolevels;
+                std::vector<int64_t> levelOffsets(numIsolevels + 1, 0);
+
+                int last = first;
+                while (last < numItems && items[last].job == j)
+                {
+                    levelOffsets[items[last].isolevel + 1] += itemSegments[last].size();
+                    ++last;
+                }
+                for (int level = 0; level < numIsolevels; ++level)
+                    levelOffsets[level + 1] += levelOffsets[level];
+
+                const std::size_t count = levelOffsets[numIsolevels];
+                const std::size_t bytes = resultBytes(numIsolevels, count);
+                responses[j] = {STATUS_OK, numIsolevels, count, bytes};
+
+                if (!jobFailed[j])
+                    resultFds[j] = createSharedBuffer("marching_squares_result", bytes, results[j]);
+
+                if (resultFds[j] < 0)
+                {
+                    // Sin destino sus bloques no se copian; la memoria que alcanzaron a usar se devuelve ya
+                    for (int i = first; i < last; ++i)
+                        std::vector<LineSegment>().swap(itemSegments[i]);
+
+                    responses[j] = {STATUS_NO_MEMORY, numIsolevels, 0, 0};
+                    first = last;
+                    continue;
+                }
+
+                ResultHeader header = {count, (uint64_t)numIsolevels};
+                std::memcpy(results[j].data(), &header, sizeof(header));
+                std::memcpy(results[j].data() + sizeof(header), levelOffsets.data(), levelOffsets.size() * sizeof(int64_t));
+
+                LineSegment *segments = reinterpret_cast<LineSegment *>(results[j].data() + sizeof(header) +
+                                                                        levelOffsets.size() * sizeof(int64_t));
+                std::size_t offset = 0;
+                for (int i = first; i < last; ++i)
+                {
+                    itemDestinations[i] = segments + offset;
+                    offset += itemSegments[i].size();
+                }
+
+                first = last;
+            }
+        }
+
+        // Los segmentos se copian directo a la memoria que va a mapear el cliente
+        #pragma omp for schedule(dynamic)
+        for (int i = 0; i < numItems; ++i)
+        {
+            if (itemDestinations[i] != nullptr)
+                std::copy(itemSegments[i].begin(), itemSegments[i].end(), itemDestinations[i]);
+        }
+    }
+
+    for (int j = 0; j < numJobs; ++j)
+    {
+        sendMessage(batch[j].connection->fd, &responses[j], sizeof(ContourResponse), resultFds[j]);
+
+        if (resultFds[j] >= 0)
+            close(resultFds[j]);
+    }
+
+    stats.jobs += numJobs;
+    stats.batches += 1;
+    stats.largestBatch = std::max(stats.largestBatch, batch.size());
+    stats.busyMs += (omp_get_wtime() - startTime) * 1000.0;
+}
+
+// Valida la petición y mapea el campo; si algo no cuadra se responde de inmediato sin pasar por la cola
+bool acceptRequest(const std::shared_ptr<Connection> &connection, const ContourRequest &request, int fieldFd, JobQueue &queue)
+{
+    bool valid = request.width >= 2 && request.height >= 2 &&
+                 request.numIsolevels >= 1 && request.numIsolevels <= MAX_ISOLEVELS && fieldFd >= 0;
+
+    // width y height entran en int32, así que el producto en size_t no desborda
+    const std::size_t cells = valid ? std::size_t(request.width) * request.height : 0;
+    valid = valid && cells * request.numIsolevels <= MAX_REQUEST_CELLS;
+
+    const std::size_t fieldBytes = valid ? cells * sizeof(float) : 0;
+
+    // El tamaño solo vale si ya no puede cambiar: el memfd tiene que venir sellado
+    const int seals = valid ? fcntl(fieldFd, F_GET_SEALS) : -1;
+    valid = valid && seals >= 0 && (seals & REQUIRED_FIELD_SEALS) == REQUIRED_FIELD_SEALS;
+
+    struct stat info;
+    valid = valid && fstat(fieldFd, &info) == 0 && std::size_t(info.st_size) >= fieldBytes;
+
+    MappedRegion field = valid ? MappedRegion::map(fieldFd, fieldBytes, false) : MappedRegion();
+
+    if (fieldFd >= 0)
+        close(fieldFd);
+
+    if (!field)
+    {
+        ContourResponse response = {STATUS_BAD_REQUEST, request.numIsolevels, 0, 0};
+        sendMessage(connection->fd, &response, sizeof(response), -1);
+        return false;
+    }
+
+    queue.push({connection, request, std::move(field)});
+    return true;
+}
+
+int runServer(const std::string &socketPath)
+{
+    int listenFd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (listenFd < 0)
+    {
+        std::cerr << "No se pudo crear el socket: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof(address.sun_path))
+    {
+        std::cerr << "Ruta del socket demasiado larga: " << socketPath << std::endl;
+        return 1;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    unlink(socketPath.c_str());
+    if (bind(listenFd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0 || listen(listenFd, 64) != 0)
+    {
+        std::cerr << "No se pudo escuchar en " << socketPath << ": " << std::strerror(errno) << std::endl;
+        close(listenFd);
+        return 1;
+    }
+
+    std::cout << "Servidor escuchando en " << socketPath << " con " << omp_get_max_threads() << " hilos." << std::endl;
+
+    JobQueue queue;
+    ServerStats stats;
+
+    std::thread dispatcher([&] {
+        std::vector<Job> batch;
+        while (queue.popBatch(batch, MAX_BATCH))
+        {
+            // Si ni siquiera se pudo armar el plan del lote, todas sus peticiones se quedan sin memoria
+            try
+            {
+                serveBatch(batch, stats);
+            }
+            catch (const std::bad_alloc &)
+            {
+                for (const Job &job : batch)
+                {
+                    ContourResponse response = {STATUS_NO_MEMORY, job.request.numIsolevels, 0, 0};
+                    sendMessage(job.connection->fd, &response, sizeof(response), -1);
+                }
+            }
+            batch.clear();
+        }
+    });
+
+    std::vector<std::shared_ptr<Connection>> connections;
+    bool running = true;
+
+    while (running)
+    {
+        std::vector<pollfd> pollFds;
+        pollFds.push_back({listenFd, POLLIN, 0});
+        for (const auto &connection : connections)
+            pollFds.push_back({connection->fd, POLLIN, 0});
+
+        if (poll(pollFds.data(), pollFds.size(), -1) < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            break;
+        }
+
+        // Primero los clientes (los índices de pollFds siguen a connections), después las conexiones nuevas
+        std::vector<std::shared_ptr<Connection>> alive;
+
+        for (std::size_t c = 0; c < connections.size(); ++c)
+        {
+            const short events = pollFds[c + 1].revents;
+
+            if (events & POLLIN)
+            {
+                ContourRequest request;
+                int fieldFd;
+                ssize_t received = receiveMessage(connections[c]->fd, &request, sizeof(request), fieldFd);
+
+                if (received <= 0)
+                    continue;
+
+                // Lo que no es del protocolo se contesta igual, así el cliente no se queda esperando
+                const bool wellFormed = received == sizeof(request) && request.magic == REQUEST_MAGIC;
+
+                if (wellFormed && request.kind == REQUEST_SHUTDOWN)
+                    running = false;
+                else if (wellFormed && request.kind == REQUEST_CONTOUR)
+                    acceptRequest(connections[c], request, fieldFd, queue);
+                else
+                {
+                    if (fieldFd >= 0)
+                        close(fieldFd);
+
+                    ContourResponse response = {STATUS_BAD_REQUEST, 0, 0, 0};
+                    sendMessage(connections[c]->fd, &response, sizeof(response), -1);
+                }
+            }
+            else if (events & (POLLHUP | POLLERR | POLLNVAL))
+            {
+                continue;
+            }
+
+            alive.push_back(connections[c]);
+        }
+
+        connections.swap(alive);
+
+        if (pollFds[0].revents & POLLIN)
+        {
+            int clientFd = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (clientFd >= 0)
+                connections.push_back(std::make_shared<Connection>(clientFd));
+        }
+    }
+
+    // Las peticiones que ya estaban en la cola se terminan de servir antes de salir
+    queue.close();
+    dispatcher.join();
+
+    connections.clear();
+    close(listenFd);
+    unlink(socketPath.c_str());
+
+    std::cout << "Servidor: " << stats.jobs << " peticiones en " << stats.batches << " lotes (promedio "
+              << (stats.batches ? double(stats.jobs) / stats.batches : 0.0) << ", máximo " << stats.largestBatch
+              << "), " << stats.busyMs << " ms trabajando." << std::endl;
+    return 0;
+}
+
+// ---------------------------------------------------------------------------
+// Cliente de prueba
+// Escribe un campo en un memfd una sola vez y lo manda en cada petición. Varios hilos cliente con su
+// propia conexión mandan peticiones a la vez, así el servidor las junta en lotes
+// ---------------------------------------------------------------------------
+int connectTo(const std::string &socketPath)
+{
+    int fd = socket(AF_UNIX, SOCK_SEQPACKET | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+        return -1;
+
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, socketPath.c_str(), sizeof(address.sun_path) - 1);
+
+    if (connect(fd, reinterpret_cast<sockaddr *>(&address), sizeof(address)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    return fd;
+}
+
+struct LatencyReport
+{
+    double mean, p50, p99, max;
+};
+
+LatencyReport summarize(std::vector<double> times)
+{
+    std::sort(times.begin(), times.end());
+
+    double sum = 0.0;
+    for (double t : times)
+        sum += t;
+
+    auto percentile = [&](double p) { return times[std::min(times.size() - 1, (std::size_t)(p * times.size()))]; };
+
+    return {sum / times.size(), percentile(0.50), percentile(0.99), times.back()};
+}
+
+void printReport(const char *label, const LatencyReport &r, std::size_t segments)
+{
+    std::cout << label << ": promedio " << r.mean << " ms, p50 " << r.p50 << " ms, p99 " << r.p99
+              << " ms, máximo " << r.max << " ms (" << segments << " segmentos)." << std::endl;
+}
+
+int runClient(const std::string &socketPath, int gridResolution, int num_contours, int requests, int clients, bool shutdown)
+{
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    num_contours = std::min(num_contours, MAX_ISOLEVELS);
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", " << num_contours << " isovalues, "
+              << clients << " clientes x " << requests << " peticiones" << std::endl;
+
+    // El campo vive en el memfd desde el principio, no hay copia para mandarlo
+    const std::size_t fieldBytes = std::size_t(gridWidth) * gridHeight * sizeof(float);
+    MappedRegion fieldRegion;
+    int fieldFd = createSharedBuffer("marching_squares_field", fieldBytes, fieldRegion, true);
+    if (fieldFd < 0)
+    {
+        std::cerr << "No se pudo crear el memfd del campo: " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    float *scalarField = reinterpret_cast<float *>(fieldRegion.data());
+    const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float dx = x - centerX;
+            float dy = y - centerY;
+            scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    // El servidor solo acepta el campo sellado; de acá en adelante se lee por el mapeo de solo lectura
+    if (!sealReadOnly(fieldFd, fieldRegion))
+    {
+        std::cerr << "No se pudo sellar el memfd del campo: " << std::strerror(errno) << std::endl;
+        close(fieldFd);
+        return 1;
+    }
+    scalarField = reinterpret_cast<float *>(fieldRegion.data());
+
+    ContourRequest request = {};
+    request.magic = REQUEST_MAGIC;
+    request.kind = REQUEST_CONTOUR;
+    request.width = gridWidth;
+    request.height = gridHeight;
+    request.numIsolevels = num_contours;
+
+    const float max_radius = gridWidth / 2.0f;
+    for (int i = 0; i < num_contours; ++i)
+        request.isolevels[i] = (float(i + 1) / num_contours) * (max_radius * 0.95f);
+
+    // Referencia local para verificar la cantidad de segmentos
+    double startTime = omp_get_wtime();
+    std::size_t expected = 0;
+    {
+        std::vector<LineSegment> segments;
+        for (int level = 0; level < num_contours; ++level)
+            for (int y = 0; y < gridHeight - 1; ++y)
+                marchRow(scalarField, gridWidth, y, request.isolevels[level], segments);
+        expected = segments.size();
+    }
+    std::cout << "Marching squares local (un hilo) tomó " << (omp_get_wtime() - startTime) * 1000.0 << " ms ("
+              << expected << " segmentos)." << std::endl;
+
+    std::vector<std::vector<double>> times(clients);
+    std::atomic<int> failures(0);
+    std::vector<std::thread> threads;
+
+    for (int c = 0; c < clients; ++c)
+    {
+        threads.emplace_back([&, c] {
+            int socketFd = connectTo(socketPath);
+            if (socketFd < 0)
+            {
+                failures += requests;
+                return;
+            }
+
+            for (int r = 0; r < requests; ++r)
+            {
+                double start = omp_get_wtime();
+
+                ContourResponse response;
+                int resultFd = -1;
+                bool ok = sendMessage(socketFd, &request, sizeof(request), fieldFd) &&
+                          receiveMessage(socketFd, &response, sizeof(response), resultFd) == sizeof(response) &&
+                          response.status == STATUS_OK && resultFd >= 0;
+
+                // El resultado se lee directo del memfd del servidor
+                if (ok)
+                {
+                    MappedRegion result = MappedRegion::map(resultFd, response.resultBytes, false);
+                    ResultHeader header = {};
+                    if (result)
+                        std::memcpy(&header, result.data(), sizeof(header));
+
+                    const int64_t *levelOffsets = reinterpret_cast<const int64_t *>(result.data() + sizeof(ResultHeader));
+                    ok = result && header.segmentCount == expected && header.numIsolevels == (uint64_t)num_contours &&
+                         levelOffsets[num_contours] == (int64_t)expected;
+                }
+
+                if (resultFd >= 0)
+                    close(resultFd);
+
+                times[c].push_back((omp_get_wtime() - start) * 1000.0);
+
+                if (!ok)
+                    ++failures;
+            }
+
+            close(socketFd);
+        });
+    }
+
+    for (std::thread &thread : threads)
+        thread.join();
+
+    std::vector<double> allTimes;
+    for (const auto &clientTimes : times)
+        allTimes.insert(allTimes.end(), clientTimes.begin(), clientTimes.end());
+
+    if (!allTimes.empty())
+        printReport("Ida y vuelta al servidor", summarize(allTimes), expected);
+
+    if (failures > 0)
+        std::cout << failures << " peticiones fallaron o no coinciden con la referencia local." << std::endl;
+
+    if (shutdown)
+    {
+        int socketFd = connectTo(socketPath);
+        if (socketFd >= 0)
+        {
+            ContourRequest stop = {};
+            stop.magic = REQUEST_MAGIC;
+            stop.kind = REQUEST_SHUTDOWN;
+            sendMessage(socketFd, &stop, sizeof(stop), -1);
+            close(socketFd);
+        }
+    }
+
+    close(fieldFd);
+    return failures > 0 ? 1 : 0;
+}
+
+int main(int argc, char *argv[])
+{
+    std::string mode = argc > 1 ? argv[1] : "";
+    std::string socketPath = argc > 2 ? argv[2] : "/tmp/marching_squares.sock";
+
+    // ./march server [socket]
+    // ./march client [socket] [tamaño_malla] [cantidad_isovalues] [peticiones_por_cliente] [clientes] [shutdown]
+    if (mode == "server")
+        return runServer(socketPath);
+
+    if (mode == "client")
+    {
+        int gridResolution = argc > 3 ? std::stoi(argv[3]) : 500;
+        int num_contours = argc > 4 ? std::max(1, std::stoi(argv[4])) : 10;
+        int requests = argc > 5 ? std::max(1, std::stoi(argv[5])) : 100;
+        int clients = argc > 6 ? std::max(1, std::stoi(argv[6])) : 4;
+        bool shutdown = argc > 7 && std::string(argv[7]) == "shutdown";
+
+        return runClient(socketPath, gridResolution, num_contours, requests, clients, shutdown);
+    }
+
+    std::cout << "Uso: ./march server [socket]" << std::endl;
+    std::cout << "     ./march client [socket] [tamaño_malla] [cantidad_isovalues] [peticiones_por_cliente] [clientes] [shutdown]" << std::endl;
+    return 1;
+}
@@ -0,0 +1,29 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="march"
+SOCKET_PATH="/tmp/marching_squares_$$.sock"
+
+if [ -n "$4" ]; then
+  export OMP_NUM_THREADS=$4
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17 -pthread
+echo "Compilación exitosa. Ejecutable creado: $EXECUTABLE_NAME"
+echo ""
+
+echo "Levantando el servidor en $SOCKET_PATH..."
+./"$EXECUTABLE_NAME" server "$SOCKET_PATH" &
+SERVER_PID=$!
+
+while [ ! -S "$SOCKET_PATH" ]; do
+  sleep 0.1
+done
+
+echo "Corriendo el cliente..."
+./"$EXECUTABLE_NAME" client "$SOCKET_PATH" "${1:-500}" "${2:-10}" "${3:-100}" "${5:-4}" shutdown
+wait $SERVER_PID
+echo ""
+
+echo "Proceso completado."
@@ -0,0 +1,447 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Segmento con los bordes de la celda que atraviesa
+// Dos segmentos vecinos comparten el id del borde, así se encadenan sin comparar floats
+struct EdgeSegment
+{
+    int edgeA, edgeB;
+    Point start, end;
+};
+
+// Igual que marchSquare, pero además guarda el id local (dentro del tile) de cada borde
+// Bordes horizontales: 2 * (ly * (tileSize + 1) + lx), verticales: el mismo índice + 1
+void marchSquare(float cell_x, float cell_y, int lx, int ly, int tileSize,
+                 float values[4],
+                 float isolevel,
+                 std::vector<EdgeSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    const int stride = tileSize + 1;
+    int edgeIds[4] = {
+        2 * (ly * stride + lx),
+        2 * (ly * stride + lx + 1) + 1,
+        2 * ((ly + 1) * stride + lx),
+        2 * (ly * stride + lx) + 1
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({edgeIds[pair[i]], edgeIds[pair[i + 1]],
+                               getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// Quita los puntos intermedios que están alineados con sus vecinos
+void mergeCollinear(std::vector<Point> &polyline)
+{
+    if (polyline.size() < 3)
+        return;
+
+    std::size_t kept = 1;
+    for (std::size_t i = 1; i + 1 < polyline.size(); ++i)
+    {
+        const Point &a = polyline[kept - 1], &b = polyline[i], &c = polyline[i + 1];
+        float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+
+        if (std::fabs(cross) > EPS)
+            polyline[kept++] = b;
+    }
+
+    polyline[kept++] = polyline.back();
+    polyline.resize(kept);
+}
+
+// Distancia de p al segmento a-b (si a == b, distancia a ese punto, para los contornos cerrados)
+float distanceToSegment(const Point &p, const Point &a, const Point &b)
+{
+    float dx = b.x - a.x, dy = b.y - a.y;
+    float lengthSq = dx * dx + dy * dy;
+    float t = 0.0f;
+
+    if (lengthSq > EPS)
+        t = std::clamp(((p.x - a.x) * dx + (p.y - a.y) * dy) / lengthSq, 0.0f, 1.0f);
+
+    float ex = a.x + t * dx - p.x, ey = a.y + t * dy - p.y;
+    return std::sqrt(ex * ex + ey * ey);
+}
+
+// Douglas-Peucker iterativo; los extremos nunca se eliminan
+void douglasPeucker(std::vector<Point> &polyline, float tolerance,
+                    std::vector<char> &keep, std::vector<std::pair<int, int>> &stack)
+{
+    const int n = (int)polyline.size();
+    if (n < 3 || tolerance <= 0.0f)
+        return;
+
+    keep.assign(n, 0);
+    keep[0] = keep[n - 1] = 1;
+
+    stack.clear();
+    stack.push_back({0, n - 1});
+
+    while (!stack.empty())
+    {
+        auto [first, last] = stack.back();
+        stack.pop_back();
+
+        float maxDistance = 0.0f;
+        int farthest = -1;
+
+        for (int i = first + 1; i < last; ++i)
+        {
+            float d = distanceToSegment(polyline[i], polyline[first], polyline[last]);
+            if (d > maxDistance)
+            {
+                maxDistance = d;
+                farthest = i;
+            }
+        }
+
+        if (farthest != -1 && maxDistance > tolerance)
+        {
+            keep[farthest] = 1;
+            stack.push_back({first, farthest});
+            stack.push_back({farthest, last});
+        }
+    }
+
+    int kept = 0;
+    for (int i = 0; i < n; ++i)
+        if (keep[i])
+            polyline[kept++] = polyline[i];
+
+    polyline.resize(kept);
+}
+
+// Buffers de cada hilo, se reutilizan entre tiles
+struct TileScratch
+{
+    std::vector<EdgeSegment> segments;
+    std::vector<int> edgeOwners;   // 2 segmentos por borde, -1 si no hay
+    std::vector<char> visited;
+    std::vector<Point> polyline;
+    std::vector<char> keep;
+    std::vector<std::pair<int, int>> stack;
+};
+
+// Encadena los segmentos del tile en polilíneas, las simplifica y las vuelve a partir en segmentos
+// Las polilíneas se cortan en los bordes del tile y sus extremos nunca se mueven,
+// así el resultado no depende de cuántos hilos hay ni de qué hilo procesa cada tile
+void simplifyTile(TileScratch &scratch, float tolerance, std::vector<LineSegment> &out)
+{
+    std::vector<EdgeSegment> &segments = scratch.segments;
+    std::vector<int> &owners = scratch.edgeOwners;
+    const int count = (int)segments.size();
+
+    for (int i = 0; i < count; ++i)
+    {
+        for (int edge : {segments[i].edgeA, segments[i].edgeB})
+        {
+            if (owners[2 * edge] == -1)
+                owners[2 * edge] = i;
+            else
+                owners[2 * edge + 1] = i;
+        }
+    }
+
+    auto degree = [&](int edge) { return (owners[2 * edge] != -1) + (owners[2 * edge + 1] != -1); };
+    auto other = [&](int edge, int seg) { return owners[2 * edge] == seg ? owners[2 * edge + 1] : owners[2 * edge]; };
+
+    scratch.visited.assign(count, 0);
+
+    // Recorre la cadena que empieza en el segmento seg entrando por el borde edge
+    auto walk = [&](int seg, int edge)
+    {
+        std::vector<Point> &polyline = scratch.polyline;
+        polyline.clear();
+
+        const EdgeSegment &first = segments[seg];
+        polyline.push_back(first.edgeA == edge ? first.start : first.end);
+
+        while (seg != -1 && !scratch.visited[seg])
+        {
+            scratch.visited[seg] = 1;
+            const EdgeSegment &s = segments[seg];
+
+            int exitEdge = s.edgeA == edge ? s.edgeB : s.edgeA;
+            polyline.push_back(s.edgeA == edge ? s.end : s.start);
+
+            seg = other(exitEdge, seg);
+            edge = exitEdge;
+        }
+
+        mergeCollinear(polyline);
+        douglasPeucker(polyline, tolerance, scratch.keep, scratch.stack);
+
+        for (std::size_t i = 0; i + 1 < polyline.size(); ++i)
+            out.push_back({polyline[i], polyline[i + 1]});
+    };
+
+    // Primero las polilíneas abiertas (empiezan en un borde con un solo segmento: seam o borde de la malla)
+    for (int i = 0; i < count; ++i)
+    {
+        if (scratch.visited[i])
+            continue;
+
+        if (degree(segments[i].edgeA) == 1)
+            walk(i, segments[i].edgeA);
+        else if (degree(segments[i].edgeB) == 1)
+            walk(i, segments[i].edgeB);
+    }
+
+    // Lo que queda son contornos cerrados dentro del tile
+    for (int i = 0; i < count; ++i)
+        if (!scratch.visited[i])
+            walk(i, segments[i].edgeA);
+
+    // Limpiamos solo los bordes que se usaron
+    for (const EdgeSegment &s : segments)
+    {
+        owners[2 * s.edgeA] = owners[2 * s.edgeA + 1] = -1;
+        owners[2 * s.edgeB] = owners[2 * s.edgeB + 1] = -1;
+    }
+}
+
+// Marching squares por tiles de tileSize x tileSize celdas con simplificación opcional
+// Con tolerance < 0 se devuelven los segmentos sin simplificar
+// La salida se concatena en orden de tile, así es determinista
+std::vector<LineSegment> contourSimplified(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                           float isolevel, int tileSize, float tolerance)
+{
+    const int cellsX = gridWidth - 1, cellsY = gridHeight - 1;
+    const int tilesX = (cellsX + tileSize - 1) / tileSize;
+    const int tilesY = (cellsY + tileSize - 1) / tileSize;
+    const int tileCount = tilesX * tilesY;
+
+    std::vector<std::vector<LineSegment>> tileSegments(tileCount);
+
+    #pragma omp parallel
+    {
+        TileScratch scratch;
+        scratch.edgeOwners.assign(4 * (tileSize + 1) * (tileSize + 1), -1);
+
+        #pragma omp for schedule(dynamic)
+        for (int t = 0; t < tileCount; ++t)
+        {
+            const int x0 = (t % tilesX) * tileSize, y0 = (t / tilesX) * tileSize;
+            const int x1 = std::min(x0 + tileSize, cellsX), y1 = std::min(y0 + tileSize, cellsY);
+
+            scratch.segments.clear();
+
+            for (int y = y0; y < y1; ++y)
+            {
+                float left_top_val = scalarField[std::size_t(y) * gridWidth + x0];
+                float left_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + x0];
+
+                for (int x = x0; x < x1; ++x)
+                {
+                    float right_top_val = scalarField[std::size_t(y) * gridWidth + (x + 1)];
+                    float right_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + (x + 1)];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, x - x0, y - y0, tileSize, values, isolevel, scratch.segments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+
+            if (tolerance < 0.0f)
+            {
+                for (const EdgeSegment &s : scratch.segments)
+                    tileSegments[t].push_back({s.start, s.end});
+            }
+            else
+            {
+                simplifyTile(scratch, tolerance, tileSegments[t]);
+            }
+        }
+    }
+
+    std::vector<std::size_t> offsets(tileCount + 1, 0);
+    for (int t = 0; t < tileCount; ++t)
+        offsets[t + 1] = offsets[t] + tileSegments[t].size();
+
+    std::vector<LineSegment> allSegments(offsets[tileCount]);
+
+    #pragma omp parallel for schedule(dynamic)
+    for (int t = 0; t < tileCount; ++t)
+    {
+        std::copy(tileSegments[t].begin(), tileSegments[t].end(), allSegments.begin() + offsets[t]);
+        std::vector<LineSegment>().swap(tileSegments[t]);
+    }
+
+    return allSegments;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 2000;
+    float tolerance = 0.5f;
+    int tileSize = 256;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: tolerancia de Douglas-Peucker en celdas (0 solo une segmentos alineados)
+    // Tercer argumento: tamaño de los tiles
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        tolerance = std::stof(argv[2]);
+
+    if (argc > 3)
+        tileSize = std::stoi(argv[3]);
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const std::string outputFilename = "lines.csv";
+
+    const float isolevel = 0.0f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    // Un campo suave tipo terreno (suma de ondas) en lugar del campo aleatorio
+    // Con 0s y 1s aleatorios cada contorno mide una celda y no hay nada que simplificar
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float u = (float)x / gridWidth, v = (float)y / gridHeight;
+            scalarField[std::size_t(y) * gridWidth + x] =
+                std::sin(12.0f * u) * std::cos(9.0f * v) +
+                0.5f * std::sin(31.0f * (u + v)) +
+                0.25f * std::cos(57.0f * u - 43.0f * v);
+        }
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<LineSegment> rawSegments = contourSimplified(scalarField, gridWidth, gridHeight, isolevel, tileSize, -1.0f);
+    double endTime = omp_get_wtime();
+
+    std::cout << "Marching squares tomó " << (endTime - startTime) * 1000.0 << " ms y generó "
+              << rawSegments.size() << " segmentos." << std::endl;
+
+    startTime = omp_get_wtime();
+    std::vector<LineSegment> allSegments = contourSimplified(scalarField, gridWidth, gridHeight, isolevel, tileSize, tolerance);
+    endTime = omp_get_wtime();
+
+    std::cout << "Marching squares + simplificación tomó " << (endTime - startTime) * 1000.0 << " ms y generó "
+              << allSegments.size() << " segmentos (" << (double)rawSegments.size() / std::max<std::size_t>(allSegments.size(), 1)
+              << "x menos)." << std::endl;
+
+    startTime = omp_get_wtime();
+    std::ofstream outputFile(outputFilename);
+
+    outputFile << "start_x,start_y,end_x,end_y\n";
+    for (const auto &segment : allSegments)
+    {
+        outputFile << segment.start.x << "," << segment.start.y << ","
+                   << segment.end.x << "," << segment.end.y << "\n";
+    }
+
+    outputFile.close();
+    endTime = omp_get_wtime();
+
+    std::cout << "Se escribieron los segmentos en " << outputFilename << " en " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,581 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// El mismo punto que calcula getEdgePoint dentro de marchSquare, para que el trazado y el barrido coincidan
+Point edgePoint(float cell_x, float cell_y, const float values[4], int e, float isolevel)
+{
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+    return lerp(corners[c0], corners[c1], values[c0], values[c1], isolevel);
+}
+
+// ---------------------------------------------------------------------------
+// Barrido completo (checkpoint 5), como referencia
+// ---------------------------------------------------------------------------
+std::vector<LineSegment> contourSweep(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                      const std::vector<float> &isolevels)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            for (float isolevel : isolevels)
+            {
+                float left_top_val = scalarField[std::size_t(y) * gridWidth];
+                float left_bottom_val = scalarField[std::size_t(y + 1) * gridWidth];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = scalarField[std::size_t(y) * gridWidth + (x + 1)];
+                    float right_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + (x + 1)];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// ---------------------------------------------------------------------------
+// Trazado de contornos
+// 1. Semillas: se revisan solo las filas y columnas múltiplo de scanStep (y los bordes) buscando
+//    bordes de celda que cruzan el isovalue. Todo contorno que no quepa dentro de un bloque
+//    scanStep x scanStep cruza alguna de esas líneas. Con scanStep = 1 se encuentran todos.
+// 2. Desde cada semilla se sigue el contorno celda por celda con edgePairs, siempre con el lado
+//    alto a la derecha, así todas las semillas de un contorno lo recorren en el mismo sentido.
+// 3. Cada semilla se reclama con un flag atómico. Un trazo reclama las semillas por las que pasa y
+//    se detiene en la primera que ya tenía dueño: cada tramo entre semillas se recorre una sola vez.
+// 4. Los tramos se unen en polilíneas siguiendo la semilla donde termina cada uno.
+// ---------------------------------------------------------------------------
+
+// Ids de los bordes entre muestras:
+//  horizontal (x, y): entre (x, y) y (x + 1, y) -> y * W + x
+//  vertical   (x, y): entre (x, y) y (x, y + 1) -> W * H + y * W + x
+struct EdgeIds
+{
+    int64_t width, height;
+
+    int64_t horizontal(int x, int y) const { return int64_t(y) * width + x; }
+    int64_t vertical(int x, int y) const { return width * height + int64_t(y) * width + x; }
+
+    // Borde local e (TOP, RIGHT, BOTTOM, LEFT) de la celda (cx, cy)
+    int64_t cellEdge(int cx, int cy, int e) const
+    {
+        switch (e)
+        {
+        case 0: return horizontal(cx, cy);
+        case 1: return vertical(cx + 1, cy);
+        case 2: return horizontal(cx, cy + 1);
+        default: return vertical(cx, cy);
+        }
+    }
+};
+
+// Tramo de un contorno entre dos semillas (endSeed = -1 si termina en el borde de la malla)
+struct TracePiece
+{
+    int64_t startSeed;
+    int64_t endSeed;
+    std::vector<Point> points;
+};
+
+struct ContourTracer
+{
+    const std::vector<float> &field;
+    int width, height;
+    float isolevel;
+    EdgeIds ids;
+
+    std::vector<int64_t> seeds; // ids de borde ordenados
+    std::unique_ptr<std::atomic<bool>[]> claimed;
+
+    ContourTracer(const std::vector<float> &f, int w, int h, float iso)
+        : field(f), width(w), height(h), isolevel(iso), ids{w, h}
+    {
+    }
+
+    float at(int x, int y) const { return field[std::size_t(y) * width + x]; }
+    bool high(int x, int y) const { return at(x, y) >= isolevel; }
+
+    bool isScanRow(int y, int scanStep) const { return y % scanStep == 0 || y == height - 1; }
+    bool isScanCol(int x, int scanStep) const { return x % scanStep == 0 || x == width - 1; }
+
+    void findSeeds(int scanStep)
+    {
+        std::vector<std::vector<int64_t>> threadSeeds(omp_get_max_threads());
+
+        #pragma omp parallel
+        {
+            std::vector<int64_t> &mySeeds = threadSeeds[omp_get_thread_num()];
+
+            #pragma omp for nowait schedule(static)
+            for (int y = 0; y < height; ++y)
+            {
+                if (!isScanRow(y, scanStep))
+                    continue;
+
+                for (int x = 0; x < width - 1; ++x)
+                    if (high(x, y) != high(x + 1, y))
+                        mySeeds.push_back(ids.horizontal(x, y));
+            }
+
+            // Columnas: se recorren por filas para leer la memoria en orden
+            #pragma omp for nowait schedule(static)
+            for (int y = 0; y < height - 1; ++y)
+            {
+                for (int x = 0; x < width; x += scanStep)
+                    if (high(x, y) != high(x, y + 1))
+                        mySeeds.push_back(ids.vertical(x, y));
+
+                if ((width - 1) % scanStep != 0 && high(width - 1, y) != high(width - 1, y + 1))
+                    mySeeds.push_back(ids.vertical(width - 1, y));
+            }
+        }
+
+        seeds.clear();
+        for (const auto &s : threadSeeds)
+            seeds.insert(seeds.end(), s.begin(), s.end());
+
+        std::sort(seeds.begin(), seeds.end());
+
+        claimed.reset(new std::atomic<bool>[seeds.size()]);
+        for (std::size_t i = 0; i < seeds.size(); ++i)
+            claimed[i].store(false, std::memory_order_relaxed);
+    }
+
+    int64_t seedIndex(int64_t edge) const
+    {
+        auto it = std::lower_bound(seeds.begin(), seeds.end(), edge);
+        return (it != seeds.end() && *it == edge) ? int64_t(it - seeds.begin()) : -1;
+    }
+
+    bool claim(int64_t seed)
+    {
+        bool expected = false;
+        return claimed[seed].compare_exchange_strong(expected, true, std::memory_order_acq_rel);
+    }
+
+    // Solo los bordes en líneas de escaneo pueden ser semillas, así casi nunca se busca
+    bool onScanLine(int cx, int cy, int e, int scanStep) const
+    {
+        switch (e)
+        {
+        case 0: return isScanRow(cy, scanStep);
+        case 1: return isScanCol(cx + 1, scanStep);
+        case 2: return isScanRow(cy + 1, scanStep);
+        default: return isScanCol(cx, scanStep);
+        }
+    }
+
+    // Celda y borde de entrada desde una semilla, con el lado alto a la derecha del avance
+    // Devuelve false si el avance sale de la malla (la semilla es el final de un contorno abierto)
+    bool entryCell(int64_t edge, int &cx, int &cy, int &entry) const
+    {
+        const int64_t horizontalEdges = ids.width * ids.height;
+
+        if (edge < horizontalEdges)
+        {
+            int x = int(edge % width), y = int(edge / width);
+            if (high(x, y))
+            {
+                cx = x; cy = y; entry = 0; // hacia abajo
+            }
+            else
+            {
+                cx = x; cy = y - 1; entry = 2; // hacia arriba
+            }
+        }
+        else
+        {
+            edge -= horizontalEdges;
+            int x = int(edge % width), y = int(edge / width);
+            if (high(x, y + 1))
+            {
+                cx = x; cy = y; entry = 3; // hacia la derecha
+            }
+            else
+            {
+                cx = x - 1; cy = y; entry = 1; // hacia la izquierda
+            }
+        }
+
+        return cx >= 0 && cy >= 0 && cx < width - 1 && cy < height - 1;
+    }
+
+    void trace(int64_t startSeed, int scanStep, std::vector<TracePiece> &pieces)
+    {
+        int cx, cy, entry;
+        if (!entryCell(seeds[startSeed], cx, cy, entry))
+            return;
+
+        if (!claim(startSeed))
+            return;
+
+        TracePiece piece = {startSeed, -1, {}};
+
+        for (bool first = true;; first = false)
+        {
+            float values[4] = {at(cx, cy), at(cx + 1, cy), at(cx + 1, cy + 1), at(cx, cy + 1)};
+
+            int caseIdx = 0;
+            if (values[0] >= isolevel) caseIdx |= 1;
+            if (values[1] >= isolevel) caseIdx |= 2;
+            if (values[2] >= isolevel) caseIdx |= 4;
+            if (values[3] >= isolevel) caseIdx |= 8;
+
+            int *pair = edgePairs[caseIdx];
+            int exit = -1;
+            for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+            {
+                if (pair[i] == entry) exit = pair[i + 1];
+                else if (pair[i + 1] == entry) exit = pair[i];
+            }
+
+            if (first)
+                piece.points.push_back(edgePoint((float)cx, (float)cy, values, entry, isolevel));
+            piece.points.push_back(edgePoint((float)cx, (float)cy, values, exit, isolevel));
+
+            if (onScanLine(cx, cy, exit, scanStep))
+            {
+                int64_t seed = seedIndex(ids.cellEdge(cx, cy, exit));
+
+                // De vuelta en la semilla inicial: contorno cerrado completo
+                if (seed == startSeed)
+                {
+                    piece.endSeed = startSeed;
+                    break;
+                }
+
+                if (seed != -1 && !claim(seed))
+                {
+                    piece.endSeed = seed;
+                    break;
+                }
+            }
+
+            static const int stepX[4] = {0, 1, 0, -1};
+            static const int stepY[4] = {-1, 0, 1, 0};
+            cx += stepX[exit];
+            cy += stepY[exit];
+            entry = (exit + 2) % 4;
+
+            if (cx < 0 || cy < 0 || cx >= width - 1 || cy >= height - 1)
+                break;
+        }
+
+        pieces.push_back(std::move(piece));
+    }
+};
+
+// Une los tramos: el tramo que termina en la semilla s sigue con el tramo que empieza en s
+std::vector<std::vector<Point>> joinPieces(std::vector<TracePiece> &pieces)
+{
+    std::vector<std::vector<Point>> polylines;
+
+    std::vector<int64_t> startSeeds(pieces.size());
+    for (std::size_t i = 0; i < pieces.size(); ++i)
+        startSeeds[i] = pieces[i].startSeed;
+
+    std::vector<std::size_t> order(pieces.size());
+    for (std::size_t i = 0; i < order.size(); ++i)
+        order[i] = i;
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return startSeeds[a] < startSeeds[b]; });
+
+    auto pieceStartingAt = [&](int64_t seed) -> int64_t
+    {
+        auto it = std::lower_bound(order.begin(), order.end(), seed,
+                                   [&](std::size_t i, int64_t s) { return startSeeds[i] < s; });
+        return (it != order.end() && startSeeds[*it] == seed) ? int64_t(*it) : -1;
+    };
+
+    std::vector<char> hasPredecessor(pieces.size(), 0), used(pieces.size(), 0);
+    for (const TracePiece &p : pieces)
+    {
+        if (p.endSeed != -1 && p.endSeed != p.startSeed)
+        {
+            int64_t next = pieceStartingAt(p.endSeed);
+            if (next != -1)
+                hasPredecessor[next] = 1;
+        }
+    }
+
+    auto follow = [&](std::size_t first)
+    {
+        std::vector<Point> line;
+        for (int64_t i = first; i != -1 && !used[i]; )
+        {
+            used[i] = 1;
+            const std::vector<Point> &pts = pieces[i].points;
+            line.insert(line.end(), line.empty() ? pts.begin() : pts.begin() + 1, pts.end());
+
+            TracePiece &p = pieces[i];
+            i = (p.endSeed == -1 || p.endSeed == p.startSeed) ? -1 : pieceStartingAt(p.endSeed);
+        }
+        polylines.push_back(std::move(line));
+    };
+
+    // Primero los contornos abiertos (empiezan en un tramo sin predecesor), después los cerrados
+    for (std::size_t i = 0; i < pieces.size(); ++i)
+        if (!hasPredecessor[i] && !used[i])
+            follow(i);
+
+    for (std::size_t i = 0; i < pieces.size(); ++i)
+        if (!used[i])
+            follow(i);
+
+    return polylines;
+}
+
+std::vector<std::vector<Point>> traceContours(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                              const std::vector<float> &isolevels, int scanStep)
+{
+    std::vector<std::vector<Point>> allPolylines;
+
+    for (float isolevel : isolevels)
+    {
+        ContourTracer tracer(scalarField, gridWidth, gridHeight, isolevel);
+        tracer.findSeeds(scanStep);
+
+        std::vector<TracePiece> pieces;
+        const int64_t numSeeds = (int64_t)tracer.seeds.size();
+
+        #pragma omp parallel
+        {
+            std::vector<TracePiece> privatePieces;
+
+            // dynamic: el largo de cada trazo es muy distinto
+            #pragma omp for nowait schedule(dynamic, 16)
+            for (int64_t s = 0; s < numSeeds; ++s)
+                tracer.trace(s, scanStep, privatePieces);
+
+            #pragma omp critical
+            for (TracePiece &p : privatePieces)
+                pieces.push_back(std::move(p));
+        }
+
+        std::vector<std::vector<Point>> polylines = joinPieces(pieces);
+        for (auto &line : polylines)
+            allPolylines.push_back(std::move(line));
+    }
+
+    return allPolylines;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+    int num_contours = 10;
+    int scanStep = 32;
+    bool writeCsv = false;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: cuántos isovalues
+    // Tercer argumento: cada cuántas filas/columnas se buscan semillas
+    // Cuarto argumento: csv para escribir lines.csv
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        num_contours = std::stoi(argv[2]);
+
+    if (argc > 3)
+        scanStep = std::max(1, std::stoi(argv[3]));
+
+    if (argc > 4)
+        writeCsv = std::string(argv[4]) == "csv";
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight
+              << ", semillas cada " << scanStep << " filas/columnas" << std::endl;
+
+    // El campo radial del checkpoint 1
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float dx = x - centerX;
+            float dy = y - centerY;
+            scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    std::vector<float> isolevels;
+    const float max_radius = gridWidth / 2.0f;
+    for (int i = 1; i <= num_contours; ++i)
+    {
+        float fraction = (float)i / (float)num_contours;
+        isolevels.push_back(fraction * (max_radius * 0.95f));
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<std::vector<Point>> polylines = traceContours(scalarField, gridWidth, gridHeight, isolevels, scanStep);
+    double traceMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    std::size_t tracedSegments = 0;
+    for (const auto &line : polylines)
+        tracedSegments += line.size() - 1;
+
+    startTime = omp_get_wtime();
+    std::size_t sweepSegments = contourSweep(scalarField, gridWidth, gridHeight, isolevels).size();
+    double sweepMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    std::cout << "Trazado tomó " << traceMs << " ms: " << polylines.size() << " polilíneas, "
+              << tracedSegments << " segmentos." << std::endl;
+    std::cout << "Barrido completo tomó " << sweepMs << " ms: " << sweepSegments << " segmentos";
+    std::cout << (sweepSegments == tracedSegments ? " (coincide)." : " (faltan contornos más chicos que el paso de escaneo).") << std::endl;
+
+    if (writeCsv)
+    {
+        const std::string outputFilename = "lines.csv";
+        std::ofstream outputFile(outputFilename);
+
+        outputFile << "start_x,start_y,end_x,end_y\n";
+        for (const auto &line : polylines)
+        {
+            for (std::size_t i = 0; i + 1 < line.size(); ++i)
+            {
+                outputFile << line[i].x << "," << line[i].y << ","
+                           << line[i + 1].x << "," << line[i + 1].y << "\n";
+            }
+        }
+
+        outputFile.close();
+        std::cout << "Se escribieron los segmentos correctamente en " << outputFilename << std::endl;
+    }
+
+    return 0;
+}
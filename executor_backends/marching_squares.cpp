@@ -0,0 +1,496 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <functional>
+#include <cmath>
+#include <cstring>
+#include <random>
+#include <iostream>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <condition_variable>
+#include <omp.h>
+
+// El backend de std::execution se compila con -DMARCHING_STD_EXECUTION
+// (con libstdc++ hace falta TBB: -ltbb)
+#ifdef MARCHING_STD_EXECUTION
+#include <execution>
+#endif
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// Una fila de celdas con el sliding window del checkpoint 5
+void marchRow(const float *scalarField, int gridWidth, int y, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Interfaz de ejecución
+// Lo único que necesita el recorrido es "corre body(i) para cada i en [0, count), en cualquier orden y
+// en cualquier hilo". Cada i escribe en su propio buffer, así ningún backend necesita ids de hilo ni
+// reducciones y el resultado es el mismo con todos
+// ---------------------------------------------------------------------------
+class Executor
+{
+public:
+    virtual ~Executor() = default;
+    virtual const char *name() const = 0;
+    virtual void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body) = 0;
+};
+
+class OpenMPExecutor : public Executor
+{
+public:
+    const char *name() const override { return "openmp"; }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body) override
+    {
+        #pragma omp parallel for schedule(dynamic)
+        for (std::size_t i = 0; i < count; ++i)
+            body(i);
+    }
+};
+
+#ifdef MARCHING_STD_EXECUTION
+// std::execution::par y no par_unseq: el cuerpo hace push_back, que puede reservar memoria,
+// y eso no se permite en un cuerpo unsequenced
+class StdExecutionExecutor : public Executor
+{
+public:
+    const char *name() const override { return "stdexec"; }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body) override
+    {
+        indices_.resize(count);
+        for (std::size_t i = 0; i < count; ++i)
+            indices_[i] = i;
+
+        std::for_each(std::execution::par, indices_.begin(), indices_.end(), [&](std::size_t i) { body(i); });
+    }
+
+private:
+    std::vector<std::size_t> indices_;
+};
+#endif
+
+// Ejecutor que da quien embebe el código: recibe una función que sabe repartir trabajo en sus propios hilos
+// Así un servicio con su propio pool no abre un segundo equipo de hilos (sin oversubscription)
+class CallerExecutor : public Executor
+{
+public:
+    using Dispatch = std::function<void(std::size_t count, const std::function<void(std::size_t)> &body)>;
+
+    explicit CallerExecutor(Dispatch dispatch) : dispatch_(std::move(dispatch)) {}
+
+    const char *name() const override { return "caller"; }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body) override
+    {
+        dispatch_(count, body);
+    }
+
+private:
+    Dispatch dispatch_;
+};
+
+// ---------------------------------------------------------------------------
+// Pool nativo con work stealing
+// Cada worker recibe un rango contiguo de índices y los toma desde el principio. Cuando se le acaba,
+// roba la mitad de atrás del rango de otro worker. Los workers duermen entre llamadas; el hilo que
+// llama trabaja como worker 0
+// ---------------------------------------------------------------------------
+class WorkStealingPool : public Executor
+{
+public:
+    explicit WorkStealingPool(int numWorkers)
+        : numWorkers_(std::max(1, numWorkers)), ranges_(new WorkerRange[numWorkers_])
+    {
+        for (int w = 1; w < numWorkers_; ++w)
+            threads_.emplace_back([this, w] { workerLoop(w); });
+    }
+
+    ~WorkStealingPool() override
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        start_.notify_all();
+
+        for (std::thread &thread : threads_)
+            thread.join();
+    }
+
+    const char *name() const override { return "pool"; }
+
+    void parallelFor(std::size_t count, const std::function<void(std::size_t)> &body) override
+    {
+        if (count == 0)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+
+            for (int w = 0; w < numWorkers_; ++w)
+            {
+                std::lock_guard<std::mutex> rangeLock(ranges_[w].lock);
+                ranges_[w].begin = count * w / numWorkers_;
+                ranges_[w].end = count * (w + 1) / numWorkers_;
+            }
+
+            body_ = &body;
+            remaining_.store(count);
+            active_ = numWorkers_ - 1;
+            ++generation_;
+        }
+        start_.notify_all();
+
+        work(0);
+
+        // body vive en el stack de quien llama: hay que esperar a que ningún worker lo siga usando
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&] { return active_ == 0; });
+        body_ = nullptr;
+    }
+
+private:
+    struct alignas(64) WorkerRange
+    {
+        std::mutex lock;
+        std::size_t begin = 0, end = 0;
+    };
+
+    const int numWorkers_;
+    std::unique_ptr<WorkerRange[]> ranges_;
+    std::vector<std::thread> threads_;
+
+    std::mutex mutex_;
+    std::condition_variable start_, done_;
+    uint64_t generation_ = 0;
+    int active_ = 0;
+    bool stop_ = false;
+
+    const std::function<void(std::size_t)> *body_ = nullptr;
+    std::atomic<std::size_t> remaining_{0};
+
+    void workerLoop(int self)
+    {
+        uint64_t seen = 0;
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_.wait(lock, [&] { return stop_ || generation_ != seen; });
+                if (stop_)
+                    return;
+                seen = generation_;
+            }
+
+            work(self);
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                --active_;
+            }
+            done_.notify_one();
+        }
+    }
+
+    bool popLocal(int self, std::size_t &index)
+    {
+        std::lock_guard<std::mutex> lock(ranges_[self].lock);
+        if (ranges_[self].begin == ranges_[self].end)
+            return false;
+
+        index = ranges_[self].begin++;
+        return true;
+    }
+
+    // Roba la mitad de atrás (redondeando hacia arriba) del rango de otro worker
+    bool steal(int self)
+    {
+        for (int offset = 1; offset < numWorkers_; ++offset)
+        {
+            WorkerRange &victim = ranges_[(self + offset) % numWorkers_];
+            std::size_t begin, end;
+
+            {
+                std::lock_guard<std::mutex> lock(victim.lock);
+                const std::size_t available = victim.end - victim.begin;
+                if (available == 0)
+                    continue;
+
+                end = victim.end;
+                begin = victim.end - (available + 1) / 2;
+                victim.end = begin;
+            }
+
+            std::lock_guard<std::mutex> lock(ranges_[self].lock);
+            ranges_[self].begin = begin;
+            ranges_[self].end = end;
+            return true;
+        }
+
+        return false;
+    }
+
+    void work(int self)
+    {
+        const std::function<void(std::size_t)> &body = *body_;
+
+        while (remaining_.load(std::memory_order_acquire) > 0)
+        {
+            std::size_t index;
+            if (popLocal(self, index))
+            {
+                body(index);
+                remaining_.fetch_sub(1, std::memory_order_acq_rel);
+            }
+            else if (!steal(self))
+            {
+                // No queda nada que robar: solo falta que terminen los índices que están corriendo
+                std::this_thread::yield();
+            }
+        }
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Recorrido por bloques de filas escrito contra Executor
+// Cada bloque tiene su buffer; después un prefix sum y la copia, también con el executor
+// ---------------------------------------------------------------------------
+std::vector<LineSegment> contour(Executor &executor, const std::vector<float> &scalarField,
+                                 int gridWidth, int gridHeight, float isolevel, int rowsPerItem)
+{
+    const int cellRows = gridHeight - 1;
+    const std::size_t numItems = (cellRows + rowsPerItem - 1) / rowsPerItem;
+    std::vector<std::vector<LineSegment>> itemSegments(numItems);
+
+    executor.parallelFor(numItems, [&](std::size_t i) {
+        const int y0 = int(i) * rowsPerItem;
+        const int y1 = std::min(cellRows, y0 + rowsPerItem);
+
+        for (int y = y0; y < y1; ++y)
+            marchRow(scalarField.data(), gridWidth, y, isolevel, itemSegments[i]);
+    });
+
+    std::vector<std::size_t> offsets(numItems + 1, 0);
+    for (std::size_t i = 0; i < numItems; ++i)
+        offsets[i + 1] = offsets[i] + itemSegments[i].size();
+
+    std::vector<LineSegment> allSegments(offsets[numItems]);
+
+    executor.parallelFor(numItems, [&](std::size_t i) {
+        std::copy(itemSegments[i].begin(), itemSegments[i].end(), allSegments.begin() + offsets[i]);
+    });
+
+    return allSegments;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 4000;
+    std::string backendArg = "all";
+    int rowsPerItem = 8;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: openmp, pool, stdexec, caller o all
+    // Tercer argumento: filas por bloque
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        backendArg = argv[2];
+
+    if (argc > 3)
+        rowsPerItem = std::max(1, std::stoi(argv[3]));
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const float isolevel = 0.5f;
+    const int numThreads = omp_get_max_threads();
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", " << numThreads << " hilos, "
+              << rowsPerItem << " filas por bloque" << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    std::mt19937 rng(42);
+    for (float &v : scalarField)
+        v = (float)(rng() % 2);
+
+    // Ejemplo de ejecutor de quien llama: un "host" que reparte el trabajo en sus propios hilos,
+    // bloques contiguos fijos por hilo
+    CallerExecutor::Dispatch hostDispatch = [numThreads](std::size_t count, const std::function<void(std::size_t)> &body) {
+        std::vector<std::thread> hostThreads;
+        for (int t = 1; t < numThreads; ++t)
+        {
+            hostThreads.emplace_back([&, t] {
+                for (std::size_t i = count * t / numThreads; i < count * (t + 1) / numThreads; ++i)
+                    body(i);
+            });
+        }
+        for (std::size_t i = 0; i < count / numThreads; ++i)
+            body(i);
+        for (std::thread &thread : hostThreads)
+            thread.join();
+    };
+
+    std::vector<std::unique_ptr<Executor>> executors;
+    if (backendArg == "openmp" || backendArg == "all")
+        executors.emplace_back(new OpenMPExecutor);
+    if (backendArg == "pool" || backendArg == "all")
+        executors.emplace_back(new WorkStealingPool(numThreads));
+#ifdef MARCHING_STD_EXECUTION
+    if (backendArg == "stdexec" || backendArg == "all")
+        executors.emplace_back(new StdExecutionExecutor);
+#else
+    if (backendArg == "stdexec")
+        std::cout << "stdexec no está disponible: compilar con -DMARCHING_STD_EXECUTION." << std::endl;
+#endif
+    if (backendArg == "caller" || backendArg == "all")
+        executors.emplace_back(new CallerExecutor(hostDispatch));
+
+    std::vector<LineSegment> reference;
+
+    for (const auto &executor : executors)
+    {
+        std::vector<LineSegment> segments;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            double startTime = omp_get_wtime();
+            segments = contour(*executor, scalarField, gridWidth, gridHeight, isolevel, rowsPerItem);
+            double endTime = omp_get_wtime();
+
+            std::cout << executor->name() << ": marching squares tomó " << (endTime - startTime) * 1000.0 << " ms ("
+                      << segments.size() << " segmentos)." << std::endl;
+        }
+
+        // El orden de salida no depende del backend: todos deben dar exactamente lo mismo
+        if (reference.empty())
+            reference = std::move(segments);
+        else if (segments.size() != reference.size() ||
+                 std::memcmp(segments.data(), reference.data(), segments.size() * sizeof(LineSegment)) != 0)
+            std::cout << executor->name() << ": la salida NO coincide con la de " << executors[0]->name() << "." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,24 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="march"
+
+if [ -n "$4" ]; then
+  export OMP_NUM_THREADS=$4
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+# Con TBB se incluye el backend de std::execution; si no está, se compila sin él
+if g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17 -pthread -DMARCHING_STD_EXECUTION -ltbb 2>/dev/null; then
+  echo "Compilación exitosa (con std::execution). Ejecutable creado: $EXECUTABLE_NAME"
+else
+  g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17 -pthread
+  echo "Compilación exitosa (sin std::execution). Ejecutable creado: $EXECUTABLE_NAME"
+fi
+echo ""
+
+echo "Corriendo el ejecutable..."
+./"$EXECUTABLE_NAME" "$1" "$2" "$3"
+echo ""
+
+echo "Proceso completado."
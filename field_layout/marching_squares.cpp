@@ -0,0 +1,500 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <random>
+#include <iostream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Layouts del campo
+//  - row: el de siempre, scalarField[y * gridWidth + x]
+//  - tiled: tiles de T x T muestras guardados uno tras otro, cada tile por filas
+//  - morton: los mismos tiles, pero dentro del tile en orden Z (Morton)
+// En los dos layouts por tiles la posición dentro del tile es offsetX[lx] + offsetY[ly]:
+//  tiled -> lx + ly * T, morton -> bits de lx y ly intercalados
+// Los tiles del borde se rellenan hasta T x T para que todos midan lo mismo
+// ---------------------------------------------------------------------------
+enum class FieldLayout
+{
+    Row,
+    Tiled,
+    Morton
+};
+
+const char *layoutName(FieldLayout layout)
+{
+    switch (layout)
+    {
+    case FieldLayout::Tiled: return "tiled";
+    case FieldLayout::Morton: return "morton";
+    default: return "row";
+    }
+}
+
+// Separa los bits de v con un 0 entre cada uno: 0b1011 -> 0b1000101
+uint32_t spreadBits(uint32_t v)
+{
+    v &= 0x0000ffff;
+    v = (v | (v << 8)) & 0x00ff00ff;
+    v = (v | (v << 4)) & 0x0f0f0f0f;
+    v = (v | (v << 2)) & 0x33333333;
+    v = (v | (v << 1)) & 0x55555555;
+    return v;
+}
+
+struct TiledField
+{
+    FieldLayout layout;
+    int width, height;
+    int tileShift, tileSize, tileMask;
+    int tilesX, tilesY;
+    std::vector<uint32_t> offsetX, offsetY;
+    std::vector<float> data;
+
+    TiledField(FieldLayout l, int w, int h, int tileShiftBits)
+        : layout(l), width(w), height(h),
+          tileShift(tileShiftBits), tileSize(1 << tileShiftBits), tileMask((1 << tileShiftBits) - 1),
+          tilesX((w + tileSize - 1) / tileSize), tilesY((h + tileSize - 1) / tileSize),
+          offsetX(tileSize), offsetY(tileSize),
+          data(std::size_t(tilesX) * tilesY * tileSize * tileSize)
+    {
+        for (int i = 0; i < tileSize; ++i)
+        {
+            if (layout == FieldLayout::Morton)
+            {
+                offsetX[i] = spreadBits(i);
+                offsetY[i] = spreadBits(i) << 1;
+            }
+            else
+            {
+                offsetX[i] = i;
+                offsetY[i] = uint32_t(i) << tileShift;
+            }
+        }
+    }
+
+    std::size_t tileBase(int tx, int ty) const
+    {
+        return (std::size_t(ty) * tilesX + tx) << (2 * tileShift);
+    }
+
+    float at(int x, int y) const
+    {
+        return data[tileBase(x >> tileShift, y >> tileShift) + offsetX[x & tileMask] + offsetY[y & tileMask]];
+    }
+};
+
+// Conversión desde row-major en paralelo: cada hilo llena tiles completos, así escribe memoria contigua
+// y lee T filas cortas del campo original
+TiledField convertFromRowMajor(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                               FieldLayout layout, int tileShift)
+{
+    TiledField field(layout, gridWidth, gridHeight, tileShift);
+    const int numTiles = field.tilesX * field.tilesY;
+
+    #pragma omp parallel for schedule(static)
+    for (int tile = 0; tile < numTiles; ++tile)
+    {
+        const int tx = tile % field.tilesX, ty = tile / field.tilesX;
+        float *out = field.data.data() + field.tileBase(tx, ty);
+
+        for (int ly = 0; ly < field.tileSize; ++ly)
+        {
+            // Relleno del borde: se repite la última fila/columna
+            const int y = std::min(ty * field.tileSize + ly, gridHeight - 1);
+            const float *row = scalarField.data() + std::size_t(y) * gridWidth;
+
+            for (int lx = 0; lx < field.tileSize; ++lx)
+            {
+                const int x = std::min(tx * field.tileSize + lx, gridWidth - 1);
+                out[field.offsetX[lx] + field.offsetY[ly]] = row[x];
+            }
+        }
+    }
+
+    return field;
+}
+
+// ---------------------------------------------------------------------------
+// Marching squares recorriendo tiles
+// Cada hilo toma tiles completos: las celdas del tile leen su propio tile, más una columna del tile de
+// la derecha y una fila del tile de abajo. Para cada fila de celdas se calculan 4 bases (arriba/abajo,
+// este tile/el de la derecha) y cada muestra es una sola suma con offsetX
+// ---------------------------------------------------------------------------
+std::vector<LineSegment> contourTiled(const TiledField &field, float isolevel)
+{
+    const int T = field.tileSize;
+    const int numTiles = field.tilesX * field.tilesY;
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait schedule(static)
+        for (int tile = 0; tile < numTiles; ++tile)
+        {
+            const int tx = tile % field.tilesX, ty = tile / field.tilesX;
+            const int x0 = tx * T, y0 = ty * T;
+            const int cellsX = std::min(T, field.width - 1 - x0);
+            const int cellsY = std::min(T, field.height - 1 - y0);
+
+            const bool hasRight = tx + 1 < field.tilesX;
+            const bool hasBelow = ty + 1 < field.tilesY;
+
+            for (int ly = 0; ly < cellsY; ++ly)
+            {
+                const float *data = field.data.data();
+                const int lyBottom = (ly + 1 < T) ? ly + 1 : 0;
+                const int tyBottom = (ly + 1 < T) ? ty : ty + 1;
+
+                // La fila de abajo puede estar en el tile de abajo; la columna T en el tile de la derecha
+                const float *top = data + field.tileBase(tx, ty) + field.offsetY[ly];
+                const float *bottom = (tyBottom == ty || hasBelow) ? data + field.tileBase(tx, tyBottom) + field.offsetY[lyBottom] : top;
+                const float *topRight = hasRight ? data + field.tileBase(tx + 1, ty) + field.offsetY[ly] : top;
+                const float *bottomRight = hasRight && (tyBottom == ty || hasBelow)
+                                               ? data + field.tileBase(tx + 1, tyBottom) + field.offsetY[lyBottom]
+                                               : bottom;
+
+                float left_top_val = top[field.offsetX[0]];
+                float left_bottom_val = bottom[field.offsetX[0]];
+
+                for (int lx = 0; lx < cellsX; ++lx)
+                {
+                    float right_top_val, right_bottom_val;
+
+                    if (lx + 1 < T)
+                    {
+                        right_top_val = top[field.offsetX[lx + 1]];
+                        right_bottom_val = bottom[field.offsetX[lx + 1]];
+                    }
+                    else
+                    {
+                        right_top_val = topRight[field.offsetX[0]];
+                        right_bottom_val = bottomRight[field.offsetX[0]];
+                    }
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)(x0 + lx), (float)(y0 + ly), values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// El loop del checkpoint 5 sobre el campo row-major
+std::vector<LineSegment> contourRowMajor(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            float left_top_val = scalarField[std::size_t(y) * gridWidth];
+            float left_bottom_val = scalarField[std::size_t(y + 1) * gridWidth];
+
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                float right_top_val = scalarField[std::size_t(y) * gridWidth + (x + 1)];
+                float right_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + (x + 1)];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// Resumen para comparar layouts: cantidad de segmentos y suma de un hash por segmento
+// Cada segmento se cuantiza a 1/1024 de celda y se ordenan sus extremos; la suma no depende del orden
+// en que los hilos entregaron los segmentos
+struct SegmentSummary
+{
+    std::size_t count;
+    uint64_t hash;
+
+    bool operator==(const SegmentSummary &other) const { return count == other.count && hash == other.hash; }
+};
+
+uint64_t mix64(uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+SegmentSummary summarize(const std::vector<LineSegment> &segments)
+{
+    uint64_t sum = 0;
+
+    for (const LineSegment &segment : segments)
+    {
+        int64_t q[4] = {
+            std::llround(segment.start.x * 1024.0), std::llround(segment.start.y * 1024.0),
+            std::llround(segment.end.x * 1024.0), std::llround(segment.end.y * 1024.0)};
+
+        if (q[2] < q[0] || (q[2] == q[0] && q[3] < q[1]))
+        {
+            std::swap(q[0], q[2]);
+            std::swap(q[1], q[3]);
+        }
+
+        uint64_t h = 0;
+        for (int64_t v : q)
+            h = mix64(h ^ (uint64_t)v);
+
+        sum += h;
+    }
+
+    return {segments.size(), sum};
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 10000;
+    std::string layoutArg = "all";
+    int tileSize = 64;
+    std::string fieldName = "radial";
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: row, tiled, morton o all
+    // Tercer argumento: tamaño del tile (potencia de 2)
+    // Cuarto argumento: radial (pocos segmentos, domina la lectura del campo) o binary (el campo aleatorio)
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        layoutArg = argv[2];
+
+    if (argc > 3)
+        tileSize = std::max(2, std::stoi(argv[3]));
+
+    if (argc > 4)
+        fieldName = argv[4];
+
+    int tileShift = 1;
+    while ((1 << (tileShift + 1)) <= tileSize && tileShift < 15)
+        ++tileShift;
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", tiles de "
+              << (1 << tileShift) << "x" << (1 << tileShift) << ", campo " << fieldName << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    float isolevel;
+
+    if (fieldName == "binary")
+    {
+        std::mt19937 rng(42);
+        for (float &v : scalarField)
+            v = (float)(rng() % 2);
+        isolevel = 0.5f;
+    }
+    else
+    {
+        const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+
+        #pragma omp parallel for schedule(static)
+        for (int y = 0; y < gridHeight; ++y)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+            {
+                float dx = x - centerX;
+                float dy = y - centerY;
+                scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+        isolevel = gridWidth / 4.0f;
+    }
+
+    std::vector<FieldLayout> layouts;
+    if (layoutArg == "row" || layoutArg == "all")
+        layouts.push_back(FieldLayout::Row);
+    if (layoutArg == "tiled" || layoutArg == "all")
+        layouts.push_back(FieldLayout::Tiled);
+    if (layoutArg == "morton" || layoutArg == "all")
+        layouts.push_back(FieldLayout::Morton);
+
+    // Referencia: la salida de row-major, calculada fuera de la medición
+    const SegmentSummary reference = summarize(contourRowMajor(scalarField, gridWidth, gridHeight, isolevel));
+    int mismatches = 0;
+
+    for (FieldLayout layout : layouts)
+    {
+        if (layout == FieldLayout::Row)
+        {
+            for (int i = 0; i < 3; ++i)
+            {
+                double startTime = omp_get_wtime();
+                std::size_t segments = contourRowMajor(scalarField, gridWidth, gridHeight, isolevel).size();
+                double endTime = omp_get_wtime();
+
+                std::cout << "row: marching squares tomó " << (endTime - startTime) * 1000.0 << " ms ("
+                          << segments << " segmentos)." << std::endl;
+            }
+            continue;
+        }
+
+        double startTime = omp_get_wtime();
+        TiledField field = convertFromRowMajor(scalarField, gridWidth, gridHeight, layout, tileShift);
+        double endTime = omp_get_wtime();
+
+        std::cout << layoutName(layout) << ": conversión desde row-major tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+
+        std::vector<LineSegment> segments;
+
+        for (int i = 0; i < 3; ++i)
+        {
+            startTime = omp_get_wtime();
+            segments = contourTiled(field, isolevel);
+            endTime = omp_get_wtime();
+
+            std::cout << layoutName(layout) << ": marching squares tomó " << (endTime - startTime) * 1000.0 << " ms ("
+                      << segments.size() << " segmentos)." << std::endl;
+        }
+
+        // Mismo multiconjunto de segmentos que row-major, sin importar el orden
+        const SegmentSummary summary = summarize(segments);
+        if (!(summary == reference))
+        {
+            std::cout << layoutName(layout) << ": la salida NO coincide con la de row (" << summary.count
+                      << " segmentos contra " << reference.count << ")." << std::endl;
+            ++mismatches;
+        }
+        else
+            std::cout << layoutName(layout) << ": la salida coincide con la de row." << std::endl;
+    }
+
+    return mismatches > 0 ? 1 : 0;
+}
@@ -0,0 +1,334 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Igual que en el checkpoint 5, pero la celda mide cellSize unidades
+// Así los segmentos de un nivel grueso quedan en coordenadas de la malla completa
+void marchSquare(float cell_x, float cell_y, float cellSize,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + cellSize, cell_y},
+        {cell_x + cellSize, cell_y + cellSize},
+        {cell_x, cell_y + cellSize}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// Un nivel de la pirámide
+// El nivel 0 apunta al scalarField original, los demás guardan su propia malla linealizada
+// La muestra (x, y) del nivel representa el bloque de scale x scale muestras de la malla completa
+struct FieldLevel
+{
+    int width, height;
+    int scale;
+    std::vector<float> storage;
+    const float *data;
+};
+
+// Reduce a la mitad promediando cada bloque de 2x2
+// En los bordes impares se repite la última fila o columna
+void downsample(const FieldLevel &src, FieldLevel &dst)
+{
+    dst.width = (src.width + 1) / 2;
+    dst.height = (src.height + 1) / 2;
+    dst.scale = src.scale * 2;
+    dst.storage.resize(std::size_t(dst.width) * dst.height);
+    dst.data = dst.storage.data();
+
+    const float *in = src.data;
+    float *out = dst.storage.data();
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < dst.height; ++y)
+    {
+        const float *row0 = in + std::size_t(2 * y) * src.width;
+        const float *row1 = in + std::size_t(std::min(2 * y + 1, src.height - 1)) * src.width;
+
+        for (int x = 0; x < dst.width; ++x)
+        {
+            int x0 = 2 * x;
+            int x1 = std::min(2 * x + 1, src.width - 1);
+
+            out[std::size_t(y) * dst.width + x] = 0.25f * (row0[x0] + row0[x1] + row1[x0] + row1[x1]);
+        }
+    }
+}
+
+// Construye la pirámide hasta que el nivel más grueso tenga a lo más minSize muestras por lado
+std::vector<FieldLevel> buildPyramid(const std::vector<float> &scalarField, int gridWidth, int gridHeight, int minSize)
+{
+    std::vector<FieldLevel> pyramid(1);
+    pyramid[0].width = gridWidth;
+    pyramid[0].height = gridHeight;
+    pyramid[0].scale = 1;
+    pyramid[0].data = scalarField.data();
+
+    while (std::max(pyramid.back().width, pyramid.back().height) > minSize)
+    {
+        FieldLevel next;
+        downsample(pyramid.back(), next);
+        pyramid.push_back(std::move(next));
+    }
+
+    return pyramid;
+}
+
+// El nivel más grueso que todavía tiene al menos outputResolution muestras por lado
+int selectLevel(const std::vector<FieldLevel> &pyramid, int outputResolution)
+{
+    int level = 0;
+
+    while (level + 1 < (int)pyramid.size() &&
+           std::max(pyramid[level + 1].width, pyramid[level + 1].height) >= outputResolution)
+        ++level;
+
+    return level;
+}
+
+// Marching squares sobre las celdas [cellX0, cellX1) x [cellY0, cellY1) de un nivel
+// Es el mismo loop del checkpoint 5 (sliding window + vectores privados por hilo)
+std::vector<LineSegment> contourLevel(const FieldLevel &level, float isolevel,
+                                      int cellX0, int cellY0, int cellX1, int cellY1)
+{
+    cellX0 = std::max(cellX0, 0);
+    cellY0 = std::max(cellY0, 0);
+    cellX1 = std::min(cellX1, level.width - 1);
+    cellY1 = std::min(cellY1, level.height - 1);
+
+    std::vector<LineSegment> allSegments;
+
+    if (cellX0 >= cellX1 || cellY0 >= cellY1)
+        return allSegments;
+
+    const float *field = level.data;
+    const int width = level.width;
+    const float cellSize = (float)level.scale;
+
+    // Centro del bloque que representa cada muestra, en coordenadas de la malla completa
+    const float offset = 0.5f * (level.scale - 1);
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = cellY0; y < cellY1; ++y)
+        {
+            float left_top_val = field[std::size_t(y) * width + cellX0];
+            float left_bottom_val = field[std::size_t(y + 1) * width + cellX0];
+
+            for (int x = cellX0; x < cellX1; ++x)
+            {
+                float right_top_val = field[std::size_t(y) * width + (x + 1)];
+                float right_bottom_val = field[std::size_t(y + 1) * width + (x + 1)];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                marchSquare(x * cellSize + offset, y * cellSize + offset, cellSize,
+                            values, isolevel, privateSegments);
+
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// Refina solo los tiles de tileSize x tileSize celdas (del nivel pedido) que tocan la región
+// La región viene en coordenadas de la malla completa
+std::vector<LineSegment> refineRegion(const FieldLevel &level, float isolevel, int tileSize,
+                                      int x0, int y0, int x1, int y1)
+{
+    int tileX0 = (x0 / level.scale) / tileSize;
+    int tileY0 = (y0 / level.scale) / tileSize;
+    int tileX1 = ((x1 + level.scale - 1) / level.scale + tileSize - 1) / tileSize;
+    int tileY1 = ((y1 + level.scale - 1) / level.scale + tileSize - 1) / tileSize;
+
+    return contourLevel(level, isolevel,
+                        tileX0 * tileSize, tileY0 * tileSize,
+                        tileX1 * tileSize, tileY1 * tileSize);
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+    int outputResolution = 1000;
+    int tileSize = 256;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: resolución de salida pedida por el visor (muestras por lado)
+    // Del tercero al sexto: región a refinar x0 y0 x1 y1 en coordenadas de la malla
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        outputResolution = std::stoi(argv[2]);
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    // La región va completa o no va: con solo una parte se avisa en vez de ignorarla
+    if (argc > 3 && argc < 7)
+    {
+        std::cerr << "La región necesita los cuatro valores: x0 y0 x1 y1" << std::endl;
+        return 1;
+    }
+
+    int region[4] = {0, 0, std::min(gridWidth, 1024), std::min(gridHeight, 1024)};
+    if (argc > 6)
+        for (int i = 0; i < 4; ++i)
+            region[i] = std::stoi(argv[3 + i]);
+
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+
+    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            scalarField[std::size_t(y) * gridWidth + x] = std::rand() % 2;
+        }
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<FieldLevel> pyramid = buildPyramid(scalarField, gridWidth, gridHeight, 64);
+    double endTime = omp_get_wtime();
+
+    std::cout << "Pirámide de " << pyramid.size() << " niveles construida en "
+              << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+
+    // Vista general: el nivel que corresponde a la resolución de salida
+    int level = selectLevel(pyramid, outputResolution);
+    const FieldLevel &overview = pyramid[level];
+
+    startTime = omp_get_wtime();
+    std::vector<LineSegment> overviewSegments = contourLevel(overview, isolevel, 0, 0, overview.width - 1, overview.height - 1);
+    endTime = omp_get_wtime();
+
+    std::cout << "Vista general (nivel " << level << ", " << overview.width << "x" << overview.height << ") tomó "
+              << (endTime - startTime) * 1000.0 << " ms y generó " << overviewSegments.size() << " segmentos." << std::endl;
+
+    // Refinamiento a resolución completa solo de los tiles que tocan la región pedida
+    startTime = omp_get_wtime();
+    std::vector<LineSegment> refinedSegments = refineRegion(pyramid[0], isolevel, tileSize,
+                                                            region[0], region[1], region[2], region[3]);
+    endTime = omp_get_wtime();
+
+    std::cout << "Refinamiento de (" << region[0] << ", " << region[1] << ") - (" << region[2] << ", " << region[3]
+              << ") tomó " << (endTime - startTime) * 1000.0 << " ms y generó " << refinedSegments.size() << " segmentos." << std::endl;
+
+    // Referencia: el barrido completo que se hacía antes
+    startTime = omp_get_wtime();
+    std::vector<LineSegment> fullSegments = contourLevel(pyramid[0], isolevel, 0, 0, gridWidth - 1, gridHeight - 1);
+    endTime = omp_get_wtime();
+
+    std::cout << "Barrido completo tomó " << (endTime - startTime) * 1000.0 << " ms y generó "
+              << fullSegments.size() << " segmentos." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,30 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="march"
+
+# ./run.sh [tamaño_malla] [resolución_salida] [hilos] [x0 y0 x1 y1]
+# Los hilos van en el tercer argumento como en las otras carpetas; la región va después, completa o no va
+if [ -n "$4$5$6$7" ] && { [ -z "$4" ] || [ -z "$5" ] || [ -z "$6" ] || [ -z "$7" ]; }; then
+  echo "La región necesita los cuatro valores: x0 y0 x1 y1" >&2
+  exit 1
+fi
+
+if [ -n "$3" ]; then
+  export OMP_NUM_THREADS=$3
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17
+echo "Compilación exitosa. Ejecutable creado: $EXECUTABLE_NAME"
+echo ""
+
+echo "Corriendo el ejecutable..."
+if [ -n "$4" ]; then
+  ./"$EXECUTABLE_NAME" "$1" "$2" "$4" "$5" "$6" "$7"
+else
+  ./"$EXECUTABLE_NAME" "$1" "$2"
+fi
+echo ""
+
+echo "Proceso completado."
@@ -0,0 +1,528 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 3D
+struct Point3
+{
+    float x, y, z;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte de la arista entre dos puntos cae el isovalue
+Point3 lerp(Point3 p1, Point3 p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y),
+            p1.z + t * (p2.z - p1.z)};
+}
+
+// ---------------------------------------------------------------------------
+// Tablas 2D de marching squares (las mismas del resto del proyecto)
+// TOP -> RIGHT -> BOTTOM -> LEFT
+// ---------------------------------------------------------------------------
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// ---------------------------------------------------------------------------
+// Tablas 3D
+// Esquina i del cubo: x = bit 0, y = bit 1, z = bit 2
+// Las 12 aristas van de la esquina con el bit en 0 a la esquina con el bit en 1
+// ---------------------------------------------------------------------------
+int cubeEdgeCorners[12][2] = {
+    {0, 1}, {2, 3}, {4, 5}, {6, 7},  // a lo largo de x
+    {0, 2}, {1, 3}, {4, 6}, {5, 7},  // a lo largo de y
+    {0, 4}, {1, 5}, {2, 6}, {3, 7}}; // a lo largo de z
+
+// Las 4 esquinas de cada cara en orden cíclico, todas antihorario vistas desde adentro del cubo
+int cubeFaces[6][4] = {
+    {0, 2, 6, 4},  // x = 0
+    {1, 5, 7, 3},  // x = 1
+    {0, 4, 5, 1},  // y = 0
+    {2, 3, 7, 6},  // y = 1
+    {0, 1, 3, 2},  // z = 0
+    {4, 6, 7, 5}}; // z = 1
+
+// Hasta 12 vértices por cubo en ciclos, como mucho 10 triángulos
+const int MAX_TRIANGLE_ENTRIES = 31;
+
+// triangleTable[caso]: aristas de los triángulos de a 3, termina en -1
+int triangleTable[256][MAX_TRIANGLE_ENTRIES];
+
+int cubeEdgeBetween(int a, int b)
+{
+    for (int e = 0; e < 12; ++e)
+    {
+        if ((cubeEdgeCorners[e][0] == a && cubeEdgeCorners[e][1] == b) ||
+            (cubeEdgeCorners[e][0] == b && cubeEdgeCorners[e][1] == a))
+            return e;
+    }
+    return -1;
+}
+
+// La tabla de triángulos se arma a partir de edgePairs en vez de escribirla a mano:
+//  1. Cada cara del cubo es un marching square: edgePairs da sus segmentos entre aristas del cubo
+//  2. Cada segmento se orienta con el lado alto a la izquierda (con las caras vistas desde adentro)
+//  3. Cada arista cortada está en 2 caras, así los segmentos forman ciclos cerrados
+//  4. Cada ciclo se triangula en abanico
+// Las caras compartidas entre dos cubos se resuelven igual desde los dos lados (los saddles 5 y 10
+// siempre dejan conectadas las esquinas altas), así la superficie queda cerrada
+void buildTriangleTable()
+{
+    const float facePos[4][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 1}};
+
+    for (int cubeCase = 0; cubeCase < 256; ++cubeCase)
+    {
+        int next[12];
+        std::fill(next, next + 12, -1);
+
+        for (const int *face : cubeFaces)
+        {
+            int squareCase = 0;
+            for (int k = 0; k < 4; ++k)
+                if (cubeCase & (1 << face[k]))
+                    squareCase |= 1 << k;
+
+            int *pair = edgePairs[squareCase];
+            for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+            {
+                int a = pair[i], b = pair[i + 1];
+
+                // La esquina alta de la arista a queda del lado alto del segmento
+                int ha = (squareCase & (1 << edgeCorners[a][0])) ? edgeCorners[a][0] : edgeCorners[a][1];
+                float ax = (facePos[edgeCorners[a][0]][0] + facePos[edgeCorners[a][1]][0]) / 2;
+                float ay = (facePos[edgeCorners[a][0]][1] + facePos[edgeCorners[a][1]][1]) / 2;
+                float bx = (facePos[edgeCorners[b][0]][0] + facePos[edgeCorners[b][1]][0]) / 2;
+                float by = (facePos[edgeCorners[b][0]][1] + facePos[edgeCorners[b][1]][1]) / 2;
+                float cross = (bx - ax) * (facePos[ha][1] - ay) - (by - ay) * (facePos[ha][0] - ax);
+
+                if (cross < 0)
+                    std::swap(a, b);
+
+                int ea = cubeEdgeBetween(face[edgeCorners[a][0]], face[edgeCorners[a][1]]);
+                int eb = cubeEdgeBetween(face[edgeCorners[b][0]], face[edgeCorners[b][1]]);
+                next[ea] = eb;
+            }
+        }
+
+        int count = 0;
+        bool visited[12] = {};
+
+        for (int start = 0; start < 12; ++start)
+        {
+            if (next[start] == -1 || visited[start])
+                continue;
+
+            std::vector<int> cycle;
+            for (int e = start; !visited[e]; e = next[e])
+            {
+                visited[e] = true;
+                cycle.push_back(e);
+            }
+
+            for (std::size_t i = 1; i + 1 < cycle.size(); ++i)
+            {
+                triangleTable[cubeCase][count++] = cycle[0];
+                triangleTable[cubeCase][count++] = cycle[i];
+                triangleTable[cubeCase][count++] = cycle[i + 1];
+            }
+        }
+
+        std::fill(triangleTable[cubeCase] + count, triangleTable[cubeCase] + MAX_TRIANGLE_ENTRIES, -1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Malla de triángulos indexada
+// ---------------------------------------------------------------------------
+struct Mesh
+{
+    std::vector<Point3> vertices;
+    std::vector<uint32_t> indices; // 3 por triángulo
+};
+
+// Volumen de width x height x depth muestras, (x, y, z) en data[(z * height + y) * width + x]
+struct Volume
+{
+    const float *data;
+    int width, height, depth;
+
+    float at(int x, int y, int z) const
+    {
+        return data[(std::size_t(z) * height + y) * width + x];
+    }
+};
+
+// Los vértices que caen en el plano de arriba de un slab los crea el slab siguiente
+// Mientras tanto se guardan como referencia externa: EXTERNAL_VERTEX | id de la arista en ese plano
+// El bit alto es la marca, así que los ids de arista (2 x ancho x alto) y los vértices locales de cada slab
+// tienen que quedar debajo de EXTERNAL_VERTEX; marchingCubes lo verifica en vez de devolver una malla rota
+const uint32_t EXTERNAL_VERTEX = 0x80000000u;
+
+// ---------------------------------------------------------------------------
+// Un slab: capas de cubos [z0, z1) procesadas por un solo hilo
+// Como el sliding window 2D (left_top_val / left_bottom_val), se reutiliza todo lo compartido:
+//  - los 4 valores de la cara izquierda de cada cubo son la cara derecha del anterior
+//  - los vértices de las aristas en el plano z + 1 se guardan en planeCache[1] y en la capa siguiente
+//    pasan a planeCache[0], así cada vértice se calcula una sola vez
+// Solo hay dos planos de caché vivos (dos slices), la memoria extra es O(ancho x alto)
+// ---------------------------------------------------------------------------
+struct BoundaryVertex
+{
+    uint32_t edge;   // id de la arista x/y en el plano
+    uint32_t vertex; // vértice local del slab
+};
+
+struct SlabOutput
+{
+    Mesh mesh;
+    // Solo las aristas del plano z0 que tienen vértice, ordenadas por id: lo que necesita el slab anterior
+    // para resolver sus referencias, proporcional a la superficie y no a ancho x alto
+    std::vector<BoundaryVertex> bottomPlane;
+    bool overflow = false; // el slab llegó a EXTERNAL_VERTEX vértices locales y se cortó
+};
+
+uint32_t boundaryVertex(const std::vector<BoundaryVertex> &plane, uint32_t edge)
+{
+    auto it = std::lower_bound(plane.begin(), plane.end(), edge,
+                               [](const BoundaryVertex &b, uint32_t e) { return b.edge < e; });
+    return it->vertex;
+}
+
+void marchSlab(const Volume &volume, float isolevel, int z0, int z1, bool ownsTopPlane, SlabOutput &out)
+{
+    const int W = volume.width, H = volume.height;
+    const std::size_t planeEdges = std::size_t(W) * H * 2;
+
+    std::vector<int> planeCache[2] = {std::vector<int>(planeEdges, -1), std::vector<int>(planeEdges, -1)};
+    std::vector<int> zCache(std::size_t(W) * H, -1);
+
+    Mesh &mesh = out.mesh;
+
+    for (int z = z0; z < z1 && !out.overflow; ++z)
+    {
+        const bool topIsExternal = (z + 1 == z1) && !ownsTopPlane;
+
+        for (int y = 0; y < H - 1 && !out.overflow; ++y)
+        {
+            // Valores de la cara izquierda: índice dy + 2 * dz
+            float left[4] = {
+                volume.at(0, y, z), volume.at(0, y + 1, z),
+                volume.at(0, y, z + 1), volume.at(0, y + 1, z + 1)};
+
+            for (int x = 0; x < W - 1; ++x)
+            {
+                float right[4] = {
+                    volume.at(x + 1, y, z), volume.at(x + 1, y + 1, z),
+                    volume.at(x + 1, y, z + 1), volume.at(x + 1, y + 1, z + 1)};
+
+                float values[8];
+                int cubeCase = 0;
+                for (int c = 0; c < 8; ++c)
+                {
+                    values[c] = (c & 1) ? right[(c >> 1)] : left[(c >> 1)];
+                    if (values[c] >= isolevel)
+                        cubeCase |= 1 << c;
+                }
+
+                if (cubeCase != 0 && cubeCase != 255)
+                {
+                    auto vertexFor = [&](int e) -> uint32_t
+                    {
+                        int ca = cubeEdgeCorners[e][0], cb = cubeEdgeCorners[e][1];
+                        int vx = x + (ca & 1), vy = y + ((ca >> 1) & 1), vz = (ca >> 2) & 1;
+                        int axis = e / 4;
+
+                        int *slot;
+                        if (axis == 2)
+                        {
+                            slot = &zCache[std::size_t(vy) * W + vx];
+                        }
+                        else
+                        {
+                            std::size_t key = (std::size_t(vy) * W + vx) * 2 + axis;
+                            if (vz == 1 && topIsExternal)
+                                return EXTERNAL_VERTEX | (uint32_t)key;
+                            slot = &planeCache[vz][key];
+                        }
+
+                        if (*slot == -1)
+                        {
+                            if (mesh.vertices.size() >= EXTERNAL_VERTEX)
+                            {
+                                out.overflow = true;
+                                return 0u;
+                            }
+
+                            Point3 pa = {(float)(x + (ca & 1)), (float)(y + ((ca >> 1) & 1)), (float)(z + ((ca >> 2) & 1))};
+                            Point3 pb = {(float)(x + (cb & 1)), (float)(y + ((cb >> 1) & 1)), (float)(z + ((cb >> 2) & 1))};
+                            *slot = (int)mesh.vertices.size();
+                            mesh.vertices.push_back(lerp(pa, pb, values[ca], values[cb], isolevel));
+                        }
+
+                        return (uint32_t)*slot;
+                    };
+
+                    const int *tri = triangleTable[cubeCase];
+                    for (int i = 0; tri[i] != -1; ++i)
+                        mesh.indices.push_back(vertexFor(tri[i]));
+                }
+
+                for (int k = 0; k < 4; ++k)
+                    left[k] = right[k];
+            }
+        }
+
+        // El plano de abajo del slab se guarda para que el slab anterior resuelva sus referencias externas
+        if (z == z0)
+        {
+            for (std::size_t key = 0; key < planeEdges; ++key)
+                if (planeCache[0][key] != -1)
+                    out.bottomPlane.push_back({(uint32_t)key, (uint32_t)planeCache[0][key]});
+        }
+
+        std::swap(planeCache[0], planeCache[1]);
+        std::fill(planeCache[1].begin(), planeCache[1].end(), -1);
+        std::fill(zCache.begin(), zCache.end(), -1);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Marching cubes por slabs de z en paralelo
+// Hay más slabs que hilos (schedule(dynamic)) para repartir bien las zonas con más superficie
+// Al final cada slab copia sus vértices y triángulos a la malla global y resuelve las referencias
+// externas con el bottomPlane del slab siguiente
+// Devuelve false si la malla no entra en índices de 32 bits (ids de arista, vértices por slab o en total)
+// ---------------------------------------------------------------------------
+const int SLABS_PER_THREAD = 4;
+
+bool marchingCubes(const Volume &volume, float isolevel, Mesh &result)
+{
+    result = Mesh();
+
+    if (std::size_t(volume.width) * volume.height * 2 > EXTERNAL_VERTEX)
+        return false;
+
+    const int layers = volume.depth - 1;
+    const int numSlabs = std::max(1, std::min(layers, omp_get_max_threads() * SLABS_PER_THREAD));
+
+    std::vector<SlabOutput> slabs(numSlabs);
+    std::vector<std::size_t> vertexOffsets(numSlabs + 1, 0), indexOffsets(numSlabs + 1, 0);
+    bool overflow = false;
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(dynamic)
+        for (int s = 0; s < numSlabs; ++s)
+        {
+            int z0 = (int)((long long)layers * s / numSlabs);
+            int z1 = (int)((long long)layers * (s + 1) / numSlabs);
+            marchSlab(volume, isolevel, z0, z1, s == numSlabs - 1, slabs[s]);
+        }
+
+        #pragma omp single
+        {
+            for (int s = 0; s < numSlabs; ++s)
+            {
+                vertexOffsets[s + 1] = vertexOffsets[s] + slabs[s].mesh.vertices.size();
+                indexOffsets[s + 1] = indexOffsets[s] + slabs[s].mesh.indices.size();
+                overflow = overflow || slabs[s].overflow;
+            }
+
+            // El índice global es uint32: a lo sumo 2^32 vértices
+            overflow = overflow || vertexOffsets[numSlabs] > std::size_t(UINT32_MAX) + 1;
+
+            if (!overflow)
+            {
+                result.vertices.resize(vertexOffsets[numSlabs]);
+                result.indices.resize(indexOffsets[numSlabs]);
+            }
+        }
+
+        #pragma omp for schedule(dynamic)
+        for (int s = 0; s < numSlabs; ++s)
+        {
+            if (overflow)
+                continue;
+
+            const Mesh &mesh = slabs[s].mesh;
+            std::copy(mesh.vertices.begin(), mesh.vertices.end(), result.vertices.begin() + vertexOffsets[s]);
+
+            for (std::size_t i = 0; i < mesh.indices.size(); ++i)
+            {
+                uint32_t v = mesh.indices[i];
+                uint32_t global;
+
+                if (v & EXTERNAL_VERTEX)
+                    global = (uint32_t)(boundaryVertex(slabs[s + 1].bottomPlane, v & ~EXTERNAL_VERTEX) + vertexOffsets[s + 1]);
+                else
+                    global = (uint32_t)(v + vertexOffsets[s]);
+
+                result.indices[indexOffsets[s] + i] = global;
+            }
+        }
+    }
+
+    return !overflow;
+}
+
+// Aristas de triángulo sin su pareja en sentido contrario: 0 en una superficie cerrada y bien orientada
+std::size_t countOpenEdges(const Mesh &mesh)
+{
+    std::vector<std::pair<uint32_t, uint32_t>> edges;
+    edges.reserve(mesh.indices.size());
+
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+    {
+        for (int k = 0; k < 3; ++k)
+            edges.push_back({mesh.indices[t + k], mesh.indices[t + (k + 1) % 3]});
+    }
+
+    std::sort(edges.begin(), edges.end());
+
+    std::size_t open = 0;
+    for (const auto &e : edges)
+    {
+        if (!std::binary_search(edges.begin(), edges.end(), std::make_pair(e.second, e.first)))
+            ++open;
+    }
+
+    return open;
+}
+
+bool writeObj(const std::string &filename, const Mesh &mesh)
+{
+    std::ofstream file(filename);
+    if (!file)
+        return false;
+
+    for (const Point3 &v : mesh.vertices)
+        file << "v " << v.x << " " << v.y << " " << v.z << "\n";
+
+    for (std::size_t t = 0; t + 2 < mesh.indices.size(); t += 3)
+        file << "f " << mesh.indices[t] + 1 << " " << mesh.indices[t + 1] + 1 << " " << mesh.indices[t + 2] + 1 << "\n";
+
+    return (bool)file;
+}
+
+int main(int argc, char *argv[])
+{
+    int volumeResolution = 128;
+    std::string fieldName = "sphere";
+    bool writeFile = false;
+
+    // Primer argumento: tamaño del volumen (N x N x N)
+    // Segundo argumento: sphere (distancia al centro, el campo radial en 3D) o gyroid
+    // Tercer argumento: obj para escribir surface.obj
+    if (argc > 1)
+        volumeResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        fieldName = argv[2];
+
+    if (argc > 3)
+        writeFile = std::string(argv[3]) == "obj";
+
+    buildTriangleTable();
+
+    const int N = volumeResolution;
+    std::vector<float> data(std::size_t(N) * N * N);
+    float isolevel;
+
+    std::cout << "\nResolución del volumen: " << N << "x" << N << "x" << N << ", campo " << fieldName << std::endl;
+
+    if (fieldName == "gyroid")
+    {
+        const float frequency = 8.0f * 3.14159265f / N;
+
+        #pragma omp parallel for schedule(static)
+        for (int z = 0; z < N; ++z)
+            for (int y = 0; y < N; ++y)
+                for (int x = 0; x < N; ++x)
+                    data[(std::size_t(z) * N + y) * N + x] =
+                        std::sin(x * frequency) * std::cos(y * frequency) +
+                        std::sin(y * frequency) * std::cos(z * frequency) +
+                        std::sin(z * frequency) * std::cos(x * frequency);
+
+        isolevel = 0.0f;
+    }
+    else
+    {
+        const float center = N / 2.0f;
+
+        #pragma omp parallel for schedule(static)
+        for (int z = 0; z < N; ++z)
+            for (int y = 0; y < N; ++y)
+                for (int x = 0; x < N; ++x)
+                {
+                    float dx = x - center, dy = y - center, dz = z - center;
+                    data[(std::size_t(z) * N + y) * N + x] = std::sqrt(dx * dx + dy * dy + dz * dz);
+                }
+
+        isolevel = N * 0.4f;
+    }
+
+    Volume volume = {data.data(), N, N, N};
+
+    double startTime = omp_get_wtime();
+    Mesh mesh;
+    const bool fits = marchingCubes(volume, isolevel, mesh);
+    double endTime = omp_get_wtime();
+
+    if (!fits)
+    {
+        std::cerr << "La malla no entra en índices de 32 bits." << std::endl;
+        return 1;
+    }
+
+    std::cout << "Marching cubes tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+    std::cout << "Se generó " << mesh.vertices.size() << " vértices y " << mesh.indices.size() / 3 << " triángulos." << std::endl;
+    std::cout << "Aristas abiertas: " << countOpenEdges(mesh) << " (solo donde la superficie corta el borde del volumen)." << std::endl;
+
+    if (writeFile)
+    {
+        const std::string outputFilename = "surface.obj";
+        if (!writeObj(outputFilename, mesh))
+        {
+            std::cerr << "No se pudo escribir " << outputFilename << std::endl;
+            return 1;
+        }
+        std::cout << "Se escribió la malla correctamente en " << outputFilename << std::endl;
+    }
+
+    return 0;
+}
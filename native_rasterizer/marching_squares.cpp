@@ -0,0 +1,532 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <fstream>
+#include <omp.h>
+#include <zlib.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Marching squares con los buffers por hilo
+// No se juntan en un vector global: el rasterizador los lee tal cual
+// ---------------------------------------------------------------------------
+std::vector<std::vector<LineSegment>> contourPerThread(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                                                       const std::vector<float> &isolevels)
+{
+    std::vector<std::vector<LineSegment>> threadSegments(omp_get_max_threads());
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> &privateSegments = threadSegments[omp_get_thread_num()];
+
+        #pragma omp for nowait schedule(static)
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            for (float isolevel : isolevels)
+            {
+                float left_top_val = scalarField[std::size_t(y) * gridWidth];
+                float left_bottom_val = scalarField[std::size_t(y + 1) * gridWidth];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = scalarField[std::size_t(y) * gridWidth + (x + 1)];
+                    float right_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + (x + 1)];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+    }
+
+    return threadSegments;
+}
+
+// ---------------------------------------------------------------------------
+// Framebuffer por tiles
+// Cada tile (TILE_SIZE x TILE_SIZE píxeles) es un bloque contiguo de coverage, así cada hilo escribe
+// solo en su propio tile y no hay locks ni false sharing
+// ---------------------------------------------------------------------------
+const int TILE_SIZE = 64;
+
+struct Framebuffer
+{
+    int width, height;
+    int tilesX, tilesY;
+    std::vector<float> coverage;
+
+    Framebuffer(int w, int h)
+        : width(w), height(h),
+          tilesX((w + TILE_SIZE - 1) / TILE_SIZE), tilesY((h + TILE_SIZE - 1) / TILE_SIZE),
+          coverage(std::size_t(tilesX) * tilesY * TILE_SIZE * TILE_SIZE, 0.0f)
+    {
+    }
+
+    float *tile(int tx, int ty)
+    {
+        return coverage.data() + (std::size_t(ty) * tilesX + tx) * TILE_SIZE * TILE_SIZE;
+    }
+};
+
+// Segmento ya pasado a coordenadas de píxel
+struct PixelSegment
+{
+    float x0, y0, x1, y1;
+};
+
+// Malla -> píxeles; el eje y se invierte para que quede igual que en matplotlib (y hacia arriba)
+struct PixelTransform
+{
+    float scale;
+    float imageHeight;
+
+    PixelSegment operator()(const LineSegment &s) const
+    {
+        return {s.start.x * scale, imageHeight - s.start.y * scale,
+                s.end.x * scale, imageHeight - s.end.y * scale};
+    }
+};
+
+// Rango de tiles que toca un segmento (bbox + 1 píxel por el splat bilineal)
+inline void tileRange(const PixelSegment &p, const Framebuffer &fb, int &tx0, int &ty0, int &tx1, int &ty1)
+{
+    auto clampTile = [](float v, int maxTile)
+    {
+        int t = (int)std::floor(v / TILE_SIZE);
+        return std::min(std::max(t, 0), maxTile - 1);
+    };
+
+    tx0 = clampTile(std::min(p.x0, p.x1) - 1.0f, fb.tilesX);
+    tx1 = clampTile(std::max(p.x0, p.x1) + 1.0f, fb.tilesX);
+    ty0 = clampTile(std::min(p.y0, p.y1) - 1.0f, fb.tilesY);
+    ty1 = clampTile(std::max(p.y0, p.y1) + 1.0f, fb.tilesY);
+}
+
+// Binning en dos pasadas (conteo + llenado) directo desde los buffers de cada hilo
+// Las dos pasadas usan schedule(static) con los mismos límites, así cada hilo ve los mismos segmentos
+// y escribe en su propio rango de cada tile sin atomics
+void binSegments(const std::vector<std::vector<LineSegment>> &threadSegments, const PixelTransform &toPixels,
+                 const Framebuffer &fb, std::vector<std::size_t> &tileOffsets, std::vector<PixelSegment> &binned)
+{
+    const int numTiles = fb.tilesX * fb.tilesY;
+    const int numThreads = omp_get_max_threads();
+    std::vector<std::size_t> counts(std::size_t(numThreads) * numTiles, 0);
+
+    tileOffsets.assign(numTiles + 1, 0);
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        const int t = omp_get_thread_num();
+        std::size_t *myCounts = counts.data() + std::size_t(t) * numTiles;
+
+        for (const std::vector<LineSegment> &buffer : threadSegments)
+        {
+            #pragma omp for schedule(static) nowait
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+            {
+                int tx0, ty0, tx1, ty1;
+                tileRange(toPixels(buffer[i]), fb, tx0, ty0, tx1, ty1);
+
+                for (int ty = ty0; ty <= ty1; ++ty)
+                    for (int tx = tx0; tx <= tx1; ++tx)
+                        ++myCounts[ty * fb.tilesX + tx];
+            }
+        }
+
+        #pragma omp barrier
+
+        // Prefix sum en orden tile -> hilo: counts pasa a ser el offset de cada hilo dentro del tile
+        #pragma omp single
+        {
+            std::size_t running = 0;
+            for (int tile = 0; tile < numTiles; ++tile)
+            {
+                tileOffsets[tile] = running;
+                for (int th = 0; th < numThreads; ++th)
+                {
+                    std::size_t c = counts[std::size_t(th) * numTiles + tile];
+                    counts[std::size_t(th) * numTiles + tile] = running;
+                    running += c;
+                }
+            }
+            tileOffsets[numTiles] = running;
+            binned.resize(running);
+        }
+
+        for (const std::vector<LineSegment> &buffer : threadSegments)
+        {
+            #pragma omp for schedule(static) nowait
+            for (std::size_t i = 0; i < buffer.size(); ++i)
+            {
+                PixelSegment p = toPixels(buffer[i]);
+                int tx0, ty0, tx1, ty1;
+                tileRange(p, fb, tx0, ty0, tx1, ty1);
+
+                for (int ty = ty0; ty <= ty1; ++ty)
+                    for (int tx = tx0; tx <= tx1; ++tx)
+                        binned[myCounts[ty * fb.tilesX + tx]++] = p;
+            }
+        }
+    }
+}
+
+// Línea con anti-aliasing: se muestrea el segmento una vez por píxel de largo y cada muestra
+// se reparte bilinealmente entre los 4 píxeles vecinos con peso largo / muestras
+// Solo se escribe lo que cae dentro del tile; el resto lo dibuja el tile vecino
+void drawSegmentInTile(const PixelSegment &p, float *tileCoverage, int originX, int originY)
+{
+    float dx = p.x1 - p.x0, dy = p.y1 - p.y0;
+    float length = std::sqrt(dx * dx + dy * dy);
+    int samples = std::max(1, (int)std::ceil(std::max(std::fabs(dx), std::fabs(dy))));
+    float weight = length / samples;
+
+    for (int s = 0; s < samples; ++s)
+    {
+        float t = (s + 0.5f) / samples;
+        float px = p.x0 + t * dx - 0.5f - originX;
+        float py = p.y0 + t * dy - 0.5f - originY;
+
+        int ix = (int)std::floor(px), iy = (int)std::floor(py);
+        float fx = px - ix, fy = py - iy;
+
+        float w[4] = {(1 - fx) * (1 - fy), fx * (1 - fy), (1 - fx) * fy, fx * fy};
+        int ox[4] = {0, 1, 0, 1}, oy[4] = {0, 0, 1, 1};
+
+        for (int k = 0; k < 4; ++k)
+        {
+            int x = ix + ox[k], y = iy + oy[k];
+            if (x >= 0 && x < TILE_SIZE && y >= 0 && y < TILE_SIZE)
+                tileCoverage[y * TILE_SIZE + x] += w[k] * weight;
+        }
+    }
+}
+
+void rasterize(Framebuffer &fb, const std::vector<std::size_t> &tileOffsets, const std::vector<PixelSegment> &binned)
+{
+    const int numTiles = fb.tilesX * fb.tilesY;
+
+    // dynamic: los tiles con contornos tienen mucho más trabajo que los vacíos
+    #pragma omp parallel for schedule(dynamic, 4)
+    for (int tile = 0; tile < numTiles; ++tile)
+    {
+        int tx = tile % fb.tilesX, ty = tile / fb.tilesX;
+        float *tileCoverage = fb.tile(tx, ty);
+
+        for (std::size_t i = tileOffsets[tile]; i < tileOffsets[tile + 1]; ++i)
+            drawSegmentInTile(binned[i], tileCoverage, tx * TILE_SIZE, ty * TILE_SIZE);
+    }
+}
+
+// Coverage por tiles -> imagen en escala de grises por filas (fondo negro, líneas blancas)
+std::vector<unsigned char> resolveImage(Framebuffer &fb)
+{
+    std::vector<unsigned char> pixels(std::size_t(fb.width) * fb.height);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < fb.height; ++y)
+    {
+        const float *tileRow = fb.tile(0, y / TILE_SIZE) + (y % TILE_SIZE) * TILE_SIZE;
+
+        for (int x = 0; x < fb.width; ++x)
+        {
+            float c = tileRow[std::size_t(x / TILE_SIZE) * TILE_SIZE * TILE_SIZE + (x % TILE_SIZE)];
+            pixels[std::size_t(y) * fb.width + x] = (unsigned char)(std::min(c, 1.0f) * 255.0f + 0.5f);
+        }
+    }
+
+    return pixels;
+}
+
+// ---------------------------------------------------------------------------
+// Escritura de la imagen
+// ---------------------------------------------------------------------------
+bool writePPM(const std::string &filename, const std::vector<unsigned char> &pixels, int width, int height)
+{
+    std::ofstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    file << "P6\n" << width << " " << height << "\n255\n";
+
+    std::vector<unsigned char> row(std::size_t(width) * 3);
+    for (int y = 0; y < height; ++y)
+    {
+        for (int x = 0; x < width; ++x)
+            std::memset(&row[std::size_t(x) * 3], pixels[std::size_t(y) * width + x], 3);
+        file.write((const char *)row.data(), row.size());
+    }
+
+    return (bool)file;
+}
+
+void writeChunk(std::ofstream &file, const char type[4], const unsigned char *data, std::size_t size)
+{
+    unsigned char header[8] = {
+        (unsigned char)(size >> 24), (unsigned char)(size >> 16), (unsigned char)(size >> 8), (unsigned char)size,
+        (unsigned char)type[0], (unsigned char)type[1], (unsigned char)type[2], (unsigned char)type[3]};
+
+    uLong crc = crc32(0L, header + 4, 4);
+    if (size > 0)
+        crc = crc32(crc, data, (uInt)size);
+
+    unsigned char footer[4] = {
+        (unsigned char)(crc >> 24), (unsigned char)(crc >> 16), (unsigned char)(crc >> 8), (unsigned char)crc};
+
+    file.write((const char *)header, 8);
+    if (size > 0)
+        file.write((const char *)data, size);
+    file.write((const char *)footer, 4);
+}
+
+// PNG en escala de grises de 8 bits, filtro 0 en cada fila y deflate con zlib nivel 1
+bool writePNG(const std::string &filename, const std::vector<unsigned char> &pixels, int width, int height)
+{
+    std::vector<unsigned char> raw(std::size_t(width + 1) * height);
+    for (int y = 0; y < height; ++y)
+    {
+        raw[std::size_t(y) * (width + 1)] = 0;
+        std::memcpy(&raw[std::size_t(y) * (width + 1) + 1], &pixels[std::size_t(y) * width], width);
+    }
+
+    uLongf compressedSize = compressBound(raw.size());
+    std::vector<unsigned char> compressed(compressedSize);
+    if (compress2(compressed.data(), &compressedSize, raw.data(), raw.size(), 1) != Z_OK)
+        return false;
+
+    std::ofstream file(filename, std::ios::binary);
+    if (!file)
+        return false;
+
+    const unsigned char signature[8] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1a, '\n'};
+    file.write((const char *)signature, 8);
+
+    unsigned char ihdr[13] = {
+        (unsigned char)(width >> 24), (unsigned char)(width >> 16), (unsigned char)(width >> 8), (unsigned char)width,
+        (unsigned char)(height >> 24), (unsigned char)(height >> 16), (unsigned char)(height >> 8), (unsigned char)height,
+        8, 0, 0, 0, 0};
+
+    writeChunk(file, "IHDR", ihdr, 13);
+    writeChunk(file, "IDAT", compressed.data(), compressedSize);
+    writeChunk(file, "IEND", nullptr, 0);
+
+    return (bool)file;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 2000;
+    int imageSize = 2048;
+    std::string fieldName = "radial";
+    std::string format = "png";
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: tamaño de la imagen en píxeles
+    // Tercer argumento: radial (checkpoint_1) o waves (suma de ondas)
+    // Cuarto argumento: png o ppm
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        imageSize = std::stoi(argv[2]);
+
+    if (argc > 3)
+        fieldName = argv[3];
+
+    if (argc > 4 && std::string(argv[4]) == "ppm")
+        format = "ppm";
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const std::string outputFilename = "contour_plot." + format;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight
+              << ", imagen de " << imageSize << "x" << imageSize << " píxeles" << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    std::vector<float> isolevels;
+
+    if (fieldName == "waves")
+    {
+        #pragma omp parallel for schedule(static)
+        for (int y = 0; y < gridHeight; ++y)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+            {
+                float u = (float)x / gridWidth, v = (float)y / gridHeight;
+                scalarField[std::size_t(y) * gridWidth + x] =
+                    std::sin(12.0f * u) * std::cos(9.0f * v) +
+                    0.5f * std::sin(31.0f * (u + v)) +
+                    0.25f * std::cos(57.0f * u - 43.0f * v);
+            }
+        }
+
+        for (int i = -4; i <= 4; ++i)
+            isolevels.push_back(0.3f * i);
+    }
+    else
+    {
+        const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+
+        #pragma omp parallel for schedule(static)
+        for (int y = 0; y < gridHeight; ++y)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+            {
+                float dx = x - centerX;
+                float dy = y - centerY;
+                scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+
+        const float max_radius = gridWidth / 2.0f;
+        for (int i = 1; i <= 10; ++i)
+            isolevels.push_back(i / 10.0f * (max_radius * 0.95f));
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<std::vector<LineSegment>> threadSegments = contourPerThread(scalarField, gridWidth, gridHeight, isolevels);
+    double endTime = omp_get_wtime();
+
+    std::size_t totalSegments = 0;
+    for (const auto &buffer : threadSegments)
+        totalSegments += buffer.size();
+
+    std::cout << "Marching squares tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+    std::cout << "Se generó " << totalSegments << " segmentos de línea para " << isolevels.size() << " isovalues." << std::endl;
+
+    startTime = omp_get_wtime();
+
+    Framebuffer fb(imageSize, imageSize);
+    PixelTransform toPixels = {(float)imageSize / (gridWidth - 1), (float)imageSize};
+    std::vector<std::size_t> tileOffsets;
+    std::vector<PixelSegment> binned;
+
+    binSegments(threadSegments, toPixels, fb, tileOffsets, binned);
+    rasterize(fb, tileOffsets, binned);
+    std::vector<unsigned char> pixels = resolveImage(fb);
+
+    endTime = omp_get_wtime();
+    std::cout << "Rasterizado tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+
+    startTime = omp_get_wtime();
+    bool written = format == "ppm" ? writePPM(outputFilename, pixels, imageSize, imageSize)
+                                   : writePNG(outputFilename, pixels, imageSize, imageSize);
+    endTime = omp_get_wtime();
+
+    if (!written)
+    {
+        std::cerr << "No se pudo escribir " << outputFilename << std::endl;
+        return 1;
+    }
+
+    std::cout << "Escritura tomó " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+    std::cout << "Imagen creada: " << outputFilename << std::endl;
+
+    return 0;
+}
@@ -8,8 +8,11 @@
 #include <iostream>
 #include <chrono>
 #include <fstream>
+#include <atomic>
 #include <omp.h>
 
+#include "../common/memory_counter.h"
+
 struct Point
 {
     float x, y;
@@ -20,11 +23,25 @@ struct LineSegment
     Point start, end;
 };
 
+// Contadores por fase; el total y el allocator están en common/memory_counter.h
+MemoryCounter fieldMemory, segmentMemory, mergeMemory;
+
+// Los vectores temporales que devuelve marchSquare por celda no se cuentan
+using FieldRow = std::vector<float, CountingAllocator<float, &fieldMemory>>;
+using ScalarField = std::vector<FieldRow, CountingAllocator<FieldRow, &fieldMemory>>;
+using MergedSegments = std::vector<LineSegment, CountingAllocator<LineSegment, &mergeMemory>>;
+
 float EPS = 1e-6f;
 
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     if (std::fabs(denom) < EPS)
         return p1;
@@ -91,6 +108,47 @@ std::vector<LineSegment> marchSquare(Point corners[4],
     return segs;
 }
 
+// Una llamada del benchmark: vector por celda, vector privado por hilo y merge en una sección crítica
+// variant_suite compila este archivo y mide esta misma función
+MergedSegments contourGrid(const ScalarField &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    MergedSegments allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment, CountingAllocator<LineSegment, &segmentMemory>> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                Point corners[4] = {
+                    {(float)x, (float)y},
+                    {(float)x + 1, (float)y},
+                    {(float)x + 1, (float)y + 1},
+                    {(float)x, (float)y + 1}};
+
+                float values[4] = {
+                    scalarField[y][x], scalarField[y][x + 1],
+                    scalarField[y + 1][x + 1], scalarField[y + 1][x]};
+                
+                std::vector<LineSegment> cellSegments = marchSquare(corners, values, isolevel);
+                
+                if (!cellSegments.empty())
+                {
+                    privateSegments.insert(privateSegments.end(), cellSegments.begin(), cellSegments.end());
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
 int main(int argc, char *argv[])
 {
     int gridResolution = 100;
@@ -103,7 +161,7 @@ int main(int argc, char *argv[])
 
     const float isolevel = 0.5f;
 
-    std::vector<std::vector<float>> scalarField(gridHeight, std::vector<float>(gridWidth));
+    ScalarField scalarField(gridHeight, FieldRow(gridWidth));
 
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 
@@ -116,47 +174,25 @@ int main(int argc, char *argv[])
     }
 
 
-    for (int i = 0; i < 5; ++i) 
+    const int iterations = 5;
+
+    for (int i = 0; i < iterations; ++i)
     {
-        std::vector<LineSegment> allSegments;
         double startTime = omp_get_wtime();
-
-        #pragma omp parallel
-        {
-            std::vector<LineSegment> privateSegments;
-
-            #pragma omp for nowait
-            for (int y = 0; y < gridHeight - 1; ++y)
-            {
-                for (int x = 0; x < gridWidth - 1; ++x)
-                {
-                    Point corners[4] = {
-                        {(float)x, (float)y},
-                        {(float)x + 1, (float)y},
-                        {(float)x + 1, (float)y + 1},
-                        {(float)x, (float)y + 1}};
-
-                    float values[4] = {
-                        scalarField[y][x], scalarField[y][x + 1],
-                        scalarField[y + 1][x + 1], scalarField[y + 1][x]};
-                    
-                    std::vector<LineSegment> cellSegments = marchSquare(corners, values, isolevel);
-                    
-                    if (!cellSegments.empty())
-                    {
-                        privateSegments.insert(privateSegments.end(), cellSegments.begin(), cellSegments.end());
-                    }
-                }
-            }
-
-            #pragma omp critical
-            allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
-        }
+        MergedSegments allSegments = contourGrid(scalarField, gridWidth, gridHeight, isolevel);
 
         double endTime = omp_get_wtime();
         double elapsedTimeMs = (endTime - startTime) * 1000.0;
 
         std::cout << elapsedTimeMs << " ms." << std::endl;
     }
+
+    std::size_t totalCells = std::size_t(gridHeight - 1) * (gridWidth - 1);
+
+    printMemoryReport("scalarField", fieldMemory);
+    printMemoryReport("privateSegments", segmentMemory, iterations);
+    printMemoryReport("allSegments", mergeMemory, iterations);
+    printTotalMemoryReport(totalCells);
+
     return 0;
 }
\ No newline at end of file
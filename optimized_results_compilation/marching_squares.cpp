@@ -8,8 +8,11 @@
 #include <iostream>
 #include <chrono>
 #include <fstream>
+#include <atomic>
 #include <omp.h>
 
+#include "../common/memory_counter.h"
+
 struct Point
 {
     float x, y;
@@ -20,10 +23,94 @@ struct LineSegment
     Point start, end;
 };
 
+// Contadores por fase; el total y el allocator están en common/memory_counter.h
+MemoryCounter fieldMemory, segmentMemory, mergeMemory;
+
+using ScalarField = std::vector<float, CountingAllocator<float, &fieldMemory>>;
+using SegmentVector = std::vector<LineSegment, CountingAllocator<LineSegment, &segmentMemory>>;
+using MergedSegments = std::vector<LineSegment, CountingAllocator<LineSegment, &mergeMemory>>;
+
+// Estadísticas del hot path, se activan compilando con -DMARCHING_STATS
+// marchSquare recibe la política como parámetro de template: con NoStats record() está vacío
+// y el compilador lo elimina, así la versión normal no paga nada
+struct NoStats
+{
+    void record(int) {}
+};
+
+// Histograma de los 16 casos por hilo; de él salen las celdas, las salidas tempranas (casos 0 y 15),
+// los saddles (5 y 10) y los segmentos (1 por caso, 2 en los saddles)
+struct alignas(64) CaseStats
+{
+    long long cases[16] = {};
+
+    void record(int caseIdx) { ++cases[caseIdx]; }
+
+    long long cells() const
+    {
+        long long total = 0;
+        for (long long c : cases)
+            total += c;
+        return total;
+    }
+
+    long long earlyExits() const { return cases[0] + cases[15]; }
+    long long saddles() const { return cases[5] + cases[10]; }
+    long long segments() const { return cells() - earlyExits() + saddles(); }
+
+    void merge(const CaseStats &other)
+    {
+        for (int i = 0; i < 16; ++i)
+            cases[i] += other.cases[i];
+    }
+};
+
+#ifdef MARCHING_STATS
+using CellStats = CaseStats;
+#else
+using CellStats = NoStats;
+#endif
+
+void printStats(const std::vector<CaseStats> &threadStats)
+{
+    CaseStats total;
+    for (const CaseStats &t : threadStats)
+        total.merge(t);
+
+    const double cells = (double)total.cells();
+
+    std::cout << "Casos:";
+    for (int i = 0; i < 16; ++i)
+        std::cout << " " << i << "=" << 100.0 * total.cases[i] / cells << "%";
+    std::cout << std::endl;
+
+    std::cout << "Salidas tempranas (casos 0 y 15): " << total.earlyExits() << " de " << total.cells() << " celdas ("
+              << 100.0 * total.earlyExits() / cells << "%), saddles (casos 5 y 10): " << total.saddles() << "." << std::endl;
+
+    long long maxSegments = 0;
+    for (std::size_t t = 0; t < threadStats.size(); ++t)
+    {
+        std::cout << "Hilo " << t << ": " << threadStats[t].cells() << " celdas, "
+                  << threadStats[t].segments() << " segmentos." << std::endl;
+        maxSegments = std::max(maxSegments, threadStats[t].segments());
+    }
+
+    double avgSegments = (double)total.segments() / threadStats.size();
+    std::cout << "Segmentos: " << total.segments() << " en total, desbalance máximo/promedio entre hilos "
+              << (avgSegments > 0 ? maxSegments / avgSegments : 0.0) << "." << std::endl;
+}
+
 float EPS = 1e-6f;
+
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
 Point lerp(Point p1, Point p2, float v1, float v2, float iso)
 {
     float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
 
     if (std::fabs(denom) < EPS)
         return p1;
@@ -56,10 +143,12 @@ int edgePairs[16][4] = {
     {-1, -1, -1, -1}  
 };
 
+template <typename Stats>
 void marchSquare(float cell_x, float cell_y,
                  float values[4],
                  float isolevel,
-                 std::vector<LineSegment>& outSegments)
+                 SegmentVector& outSegments,
+                 Stats &stats)
 {
 
     int caseIdx = 0;
@@ -69,6 +158,8 @@ void marchSquare(float cell_x, float cell_y,
     if (values[2] >= isolevel) caseIdx |= 4;
     if (values[3] >= isolevel) caseIdx |= 8;
 
+    stats.record(caseIdx);
+
     if (caseIdx == 0 || caseIdx == 15)
         return;
 
@@ -95,6 +186,50 @@ void marchSquare(float cell_x, float cell_y,
     }
 }
 
+// Una llamada del benchmark: sliding window por fila, vector privado por hilo y merge en una sección crítica
+// threadStats tiene una entrada por hilo; variant_suite compila este archivo y mide esta misma función
+MergedSegments contourGrid(const ScalarField &scalarField, int gridWidth, int gridHeight, float isolevel,
+                           std::vector<CellStats> &threadStats)
+{
+    MergedSegments allSegments;
+
+    #pragma omp parallel
+    {
+        SegmentVector privateSegments;
+        CellStats &myStats = threadStats[omp_get_thread_num()];
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            float left_top_val = scalarField[y * gridWidth];
+            float left_bottom_val = scalarField[(y + 1) * gridWidth];
+
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                float right_top_val = scalarField[y * gridWidth + (x + 1)];
+                float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                marchSquare((float)x, (float)y, values, isolevel, privateSegments, myStats);
+
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
 int main(int argc, char *argv[])
 {
     int gridResolution = 100;
@@ -107,7 +242,7 @@ int main(int argc, char *argv[])
 
     const float isolevel = 0.5f;
 
-    std::vector<float> scalarField(gridWidth * gridHeight);
+    ScalarField scalarField(gridWidth * gridHeight);
 
     std::srand(static_cast<unsigned int>(std::time(nullptr)));
 
@@ -119,49 +254,34 @@ int main(int argc, char *argv[])
         }
     }
 
-    for (int i = 0; i < 10; ++i) 
-    {
-        std::vector<LineSegment> allSegments;
+    std::vector<CellStats> threadStats(omp_get_max_threads());
 
-        double startTime = omp_get_wtime();
+    const int iterations = 10;
 
-        #pragma omp parallel
-        {
-            std::vector<LineSegment> privateSegments;
+    for (int i = 0; i < iterations; ++i)
+    {
+        std::fill(threadStats.begin(), threadStats.end(), CellStats());
 
-            #pragma omp for nowait
-            for (int y = 0; y < gridHeight - 1; ++y)
-            {
-                float left_top_val = scalarField[y * gridWidth];
-                float left_bottom_val = scalarField[(y + 1) * gridWidth];
-
-                for (int x = 0; x < gridWidth - 1; ++x)
-                {
-                    float right_top_val = scalarField[y * gridWidth + (x + 1)];
-                    float right_bottom_val = scalarField[(y + 1) * gridWidth + (x + 1)];
-
-                    float values[4] = {
-                        left_top_val,
-                        right_top_val,
-                        right_bottom_val,
-                        left_bottom_val
-                    };
-
-                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
-
-                    left_top_val = right_top_val;
-                    left_bottom_val = right_bottom_val;
-                }
-            }
 
-            #pragma omp critical
-            allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
-        }
+        double startTime = omp_get_wtime();
+        MergedSegments allSegments = contourGrid(scalarField, gridWidth, gridHeight, isolevel, threadStats);
 
         double endTime = omp_get_wtime();
         double elapsedTimeMs = (endTime - startTime) * 1000.0;
 
         std::cout << elapsedTimeMs << " ms." << std::endl;
     }
+
+    std::size_t totalCells = std::size_t(gridHeight - 1) * (gridWidth - 1);
+
+    printMemoryReport("scalarField", fieldMemory);
+    printMemoryReport("privateSegments", segmentMemory, iterations);
+    printMemoryReport("allSegments", mergeMemory, iterations);
+    printTotalMemoryReport(totalCells);
+
+#ifdef MARCHING_STATS
+    printStats(threadStats);
+#endif
+
     return 0;
 }
\ No newline at end of file
@@ -0,0 +1,409 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <iostream>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Campos procedurales
+// Cualquier tipo con float operator()(int x, int y) const sirve como campo
+// ---------------------------------------------------------------------------
+
+// Distancia al centro, el mismo campo del checkpoint 1
+struct RadialField
+{
+    float centerX, centerY;
+
+    float operator()(int x, int y) const
+    {
+        float dx = x - centerX;
+        float dy = y - centerY;
+        return std::sqrt(dx * dx + dy * dy);
+    }
+};
+
+// Signed distance de la unión de varios círculos (negativo adentro)
+struct CirclesSdfField
+{
+    struct Circle
+    {
+        float x, y, radius;
+    };
+
+    std::vector<Circle> circles;
+
+    float operator()(int x, int y) const
+    {
+        float best = 1e30f;
+        for (const Circle &c : circles)
+        {
+            float dx = x - c.x;
+            float dy = y - c.y;
+            best = std::min(best, std::sqrt(dx * dx + dy * dy) - c.radius);
+        }
+        return best;
+    }
+};
+
+// Función implícita: suma de metaballs, el contorno es donde la suma vale el isovalue
+struct MetaballField
+{
+    struct Ball
+    {
+        float x, y, radiusSq;
+    };
+
+    std::vector<Ball> balls;
+
+    float operator()(int x, int y) const
+    {
+        float sum = 0.0f;
+        for (const Ball &b : balls)
+        {
+            float dx = x - b.x;
+            float dy = y - b.y;
+            sum += b.radiusSq / (dx * dx + dy * dy + 1.0f);
+        }
+        return sum;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Marching squares fusionado con la evaluación del campo
+// Cada hilo toma un bloque contiguo de filas y guarda solo 2 filas del campo (arriba y abajo)
+// La fila de abajo se evalúa, se procesa la fila de celdas para todos los isovalues y pasa a ser la de arriba
+// Así cada muestra se evalúa una vez (más una fila por bloque) y nunca existe la malla W x H
+// ---------------------------------------------------------------------------
+template <typename Field>
+std::vector<LineSegment> contourProcedural(const Field &field, int gridWidth, int gridHeight,
+                                           const std::vector<float> &isolevels)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        const int numThreads = omp_get_num_threads();
+        const int threadId = omp_get_thread_num();
+
+        // Bloque de filas de celdas [rowBegin, rowEnd) de este hilo
+        const int cellRows = gridHeight - 1;
+        const int rowBegin = (int)((long long)cellRows * threadId / numThreads);
+        const int rowEnd = (int)((long long)cellRows * (threadId + 1) / numThreads);
+
+        std::vector<LineSegment> privateSegments;
+        std::vector<float> topRow(gridWidth), bottomRow(gridWidth);
+
+        if (rowBegin < rowEnd)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+                topRow[x] = field(x, rowBegin);
+        }
+
+        for (int y = rowBegin; y < rowEnd; ++y)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+                bottomRow[x] = field(x, y + 1);
+
+            for (float isolevel : isolevels)
+            {
+                float left_top_val = topRow[0];
+                float left_bottom_val = bottomRow[0];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = topRow[x + 1];
+                    float right_bottom_val = bottomRow[x + 1];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+
+            std::swap(topRow, bottomRow);
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// La forma de siempre: se escribe la malla completa y después se lee, como referencia
+template <typename Field>
+std::vector<LineSegment> contourMaterialized(const Field &field, int gridWidth, int gridHeight,
+                                             const std::vector<float> &isolevels)
+{
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+
+    #pragma omp parallel for
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+            scalarField[std::size_t(y) * gridWidth + x] = field(x, y);
+    }
+
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            for (float isolevel : isolevels)
+            {
+                float left_top_val = scalarField[std::size_t(y) * gridWidth];
+                float left_bottom_val = scalarField[std::size_t(y + 1) * gridWidth];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = scalarField[std::size_t(y) * gridWidth + (x + 1)];
+                    float right_bottom_val = scalarField[std::size_t(y + 1) * gridWidth + (x + 1)];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// Solo se compara contra la versión materializada si la malla cabe en este límite
+const double MATERIALIZE_LIMIT_MB = 1024.0;
+
+template <typename Field>
+void runField(const Field &field, int gridWidth, int gridHeight, const std::vector<float> &isolevels, bool writeCsv)
+{
+    double startTime = omp_get_wtime();
+    std::vector<LineSegment> segments = contourProcedural(field, gridWidth, gridHeight, isolevels);
+    double fusedMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    double rowsMB = 2.0 * sizeof(float) * gridWidth / (1024.0 * 1024.0);
+    double gridMB = (double)sizeof(float) * gridWidth * gridHeight / (1024.0 * 1024.0);
+
+    std::cout << "Marching squares fusionado tomó " << fusedMs << " ms." << std::endl;
+    std::cout << "Se generó " << segments.size() << " segmentos de línea para " << isolevels.size() << " isovalues." << std::endl;
+    std::cout << "Memoria del campo: " << rowsMB << " MB por hilo (malla completa: " << gridMB << " MB)." << std::endl;
+
+    if (gridMB <= MATERIALIZE_LIMIT_MB)
+    {
+        startTime = omp_get_wtime();
+        std::size_t reference = contourMaterialized(field, gridWidth, gridHeight, isolevels).size();
+        double materializedMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        std::cout << "Con la malla materializada tomó " << materializedMs << " ms (" << reference << " segmentos";
+        std::cout << (reference == segments.size() ? ", coincide)." : ", NO coincide).") << std::endl;
+    }
+
+    if (writeCsv)
+    {
+        const std::string outputFilename = "lines.csv";
+        std::ofstream outputFile(outputFilename);
+
+        outputFile << "start_x,start_y,end_x,end_y\n";
+        for (const auto &segment : segments)
+        {
+            outputFile << segment.start.x << "," << segment.start.y << ","
+                       << segment.end.x << "," << segment.end.y << "\n";
+        }
+
+        outputFile.close();
+        std::cout << "Se escribieron los segmentos correctamente en " << outputFilename << std::endl;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+    int num_contours = 10;
+    std::string fieldName = "radial";
+    bool writeCsv = false;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: cuántos isovalues
+    // Tercer argumento: radial, sdf o metaballs
+    // Cuarto argumento: csv para escribir lines.csv
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        num_contours = std::stoi(argv[2]);
+
+    if (argc > 3)
+        fieldName = argv[3];
+
+    if (argc > 4)
+        writeCsv = std::string(argv[4]) == "csv";
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const float size = (float)gridResolution;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", campo " << fieldName << std::endl;
+
+    std::vector<float> isolevels;
+
+    if (fieldName == "sdf")
+    {
+        CirclesSdfField field;
+        field.circles = {
+            {0.30f * size, 0.35f * size, 0.18f * size},
+            {0.62f * size, 0.40f * size, 0.22f * size},
+            {0.45f * size, 0.72f * size, 0.15f * size}};
+
+        // Curvas de nivel a ambos lados de la superficie (distancia 0)
+        for (int i = 0; i < num_contours; ++i)
+            isolevels.push_back((i - num_contours / 2) * 0.02f * size);
+
+        runField(field, gridWidth, gridHeight, isolevels, writeCsv);
+    }
+    else if (fieldName == "metaballs")
+    {
+        MetaballField field;
+        field.balls = {
+            {0.35f * size, 0.40f * size, 0.01f * size * size},
+            {0.60f * size, 0.45f * size, 0.015f * size * size},
+            {0.50f * size, 0.70f * size, 0.008f * size * size},
+            {0.25f * size, 0.70f * size, 0.005f * size * size}};
+
+        for (int i = 1; i <= num_contours; ++i)
+            isolevels.push_back(0.5f + 0.1f * i);
+
+        runField(field, gridWidth, gridHeight, isolevels, writeCsv);
+    }
+    else
+    {
+        RadialField field = {size / 2.0f, size / 2.0f};
+        const float max_radius = size / 2.0f;
+
+        for (int i = 1; i <= num_contours; ++i)
+        {
+            float fraction = (float)i / (float)num_contours;
+            isolevels.push_back(fraction * (max_radius * 0.95f));
+        }
+
+        runField(field, gridWidth, gridHeight, isolevels, writeCsv);
+    }
+
+    return 0;
+}
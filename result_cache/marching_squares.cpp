@@ -0,0 +1,758 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+#include <iostream>
+#include <filesystem>
+#include <optional>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+static_assert(sizeof(LineSegment) == 4 * sizeof(float), "LineSegment se guarda en disco como 4 floats");
+
+// Resultado de una barrida: segmentos agrupados por isovalue
+// Los segmentos del isovalue i son segments[levelOffsets[i] .. levelOffsets[i + 1])
+struct ContourResult
+{
+    std::vector<LineSegment> segments;
+    std::vector<int64_t> levelOffsets;
+};
+
+// Igual que en shared_library: cada hilo guarda sus segmentos por isovalue y al final se copian en paralelo
+ContourResult contourLevels(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                            const std::vector<float> &isolevels)
+{
+    const int numThreads = omp_get_max_threads();
+    const int numIsolevels = (int)isolevels.size();
+    std::vector<std::vector<std::vector<LineSegment>>> threadSegments(
+        numThreads, std::vector<std::vector<LineSegment>>(numIsolevels));
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        auto &mySegments = threadSegments[omp_get_thread_num()];
+
+        for (int level = 0; level < numIsolevels; ++level)
+        {
+            const float isolevel = isolevels[level];
+            std::vector<LineSegment> &out = mySegments[level];
+
+            #pragma omp for nowait schedule(static)
+            for (int y = 0; y < gridHeight - 1; ++y)
+            {
+                const float *top = scalarField.data() + std::size_t(y) * gridWidth;
+                const float *bottom = top + gridWidth;
+
+                float left_top_val = top[0];
+                float left_bottom_val = bottom[0];
+
+                for (int x = 0; x < gridWidth - 1; ++x)
+                {
+                    float right_top_val = top[x + 1];
+                    float right_bottom_val = bottom[x + 1];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)x, (float)y, values, isolevel, out);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+    }
+
+    ContourResult result;
+    std::vector<std::size_t> blockOffsets(std::size_t(numIsolevels) * numThreads + 1, 0);
+    result.levelOffsets.assign(numIsolevels + 1, 0);
+
+    for (int level = 0; level < numIsolevels; ++level)
+    {
+        for (int t = 0; t < numThreads; ++t)
+        {
+            std::size_t block = std::size_t(level) * numThreads + t;
+            blockOffsets[block + 1] = blockOffsets[block] + threadSegments[t][level].size();
+        }
+        result.levelOffsets[level + 1] = (int64_t)blockOffsets[std::size_t(level + 1) * numThreads];
+    }
+
+    result.segments.resize(blockOffsets.back());
+
+    #pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int t = 0; t < numThreads; ++t)
+    {
+        for (int level = 0; level < numIsolevels; ++level)
+        {
+            const std::vector<LineSegment> &block = threadSegments[t][level];
+            std::copy(block.begin(), block.end(),
+                      result.segments.begin() + blockOffsets[std::size_t(level) * numThreads + t]);
+        }
+    }
+
+    return result;
+}
+
+// ---------------------------------------------------------------------------
+// Hash del contenido
+// El campo se parte en bloques de HASH_CHUNK floats que se hashean en paralelo (4 lanes por bloque,
+// la ronda de xxHash64). Los hashes de los bloques se combinan en orden junto con las dimensiones y
+// los isovalues, así la llave no depende de cuántos hilos haya
+// ---------------------------------------------------------------------------
+const std::size_t HASH_CHUNK = std::size_t(1) << 20;
+
+const uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+const uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+
+inline uint64_t rotl64(uint64_t v, int r)
+{
+    return (v << r) | (v >> (64 - r));
+}
+
+inline uint64_t hashRound(uint64_t acc, uint64_t word)
+{
+    return rotl64(acc + word * PRIME2, 31) * PRIME1;
+}
+
+// Finalizador de splitmix64
+inline uint64_t mix64(uint64_t v)
+{
+    v ^= v >> 30;
+    v *= 0xBF58476D1CE4E5B9ull;
+    v ^= v >> 27;
+    v *= 0x94D049BB133111EBull;
+    v ^= v >> 31;
+    return v;
+}
+
+struct CacheKey
+{
+    uint64_t hi = 0, lo = 0;
+
+    void add(uint64_t word)
+    {
+        hi = mix64(hi ^ hashRound(PRIME1, word));
+        lo = mix64(rotl64(lo, 23) + word * PRIME2);
+    }
+
+    std::string hex() const
+    {
+        static const char digits[] = "0123456789abcdef";
+        std::string out(32, '0');
+        for (int i = 0; i < 16; ++i)
+        {
+            out[15 - i] = digits[(hi >> (4 * i)) & 15];
+            out[31 - i] = digits[(lo >> (4 * i)) & 15];
+        }
+        return out;
+    }
+};
+
+// Hash de 128 bits de un bloque: las lanes 0 y 2 dan la mitad alta, 1 y 3 la baja
+void hashChunk(const float *data, std::size_t count, uint64_t &hi, uint64_t &lo)
+{
+    uint64_t acc[4] = {PRIME1, PRIME2, ~PRIME1, ~PRIME2};
+    const unsigned char *bytes = reinterpret_cast<const unsigned char *>(data);
+    const std::size_t numWords = count / 2;
+
+    std::size_t w = 0;
+    for (; w + 4 <= numWords; w += 4)
+    {
+        uint64_t words[4];
+        std::memcpy(words, bytes + w * 8, sizeof(words));
+
+        for (int lane = 0; lane < 4; ++lane)
+            acc[lane] = hashRound(acc[lane], words[lane]);
+    }
+
+    for (; w < numWords; ++w)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + w * 8, 8);
+        acc[w & 3] = hashRound(acc[w & 3], word);
+    }
+
+    // Un float suelto al final
+    if (count & 1)
+    {
+        uint32_t last;
+        std::memcpy(&last, data + count - 1, 4);
+        acc[0] = hashRound(acc[0], last);
+    }
+
+    hi = mix64(acc[0] ^ rotl64(acc[2], 17) ^ count);
+    lo = mix64(acc[1] ^ rotl64(acc[3], 29) ^ (count * PRIME1));
+}
+
+CacheKey hashRequest(const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                     const std::vector<float> &isolevels)
+{
+    const std::size_t numSamples = scalarField.size();
+    const std::size_t numChunks = (numSamples + HASH_CHUNK - 1) / HASH_CHUNK;
+    std::vector<uint64_t> chunkHi(numChunks), chunkLo(numChunks);
+
+    #pragma omp parallel for schedule(static)
+    for (std::size_t c = 0; c < numChunks; ++c)
+    {
+        const std::size_t begin = c * HASH_CHUNK;
+        const std::size_t count = std::min(HASH_CHUNK, numSamples - begin);
+        hashChunk(scalarField.data() + begin, count, chunkHi[c], chunkLo[c]);
+    }
+
+    CacheKey key;
+    key.add(uint64_t(gridWidth));
+    key.add(uint64_t(gridHeight));
+    key.add(uint64_t(isolevels.size()));
+
+    for (float isolevel : isolevels)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &isolevel, 4);
+        key.add(bits);
+    }
+
+    for (std::size_t c = 0; c < numChunks; ++c)
+    {
+        key.add(chunkHi[c]);
+        key.add(chunkLo[c]);
+    }
+
+    return key;
+}
+
+// ---------------------------------------------------------------------------
+// Formato en disco (<llave>.msc), pensado para usarse directo con mmap:
+//   CacheFileHeader | isolevels (float, relleno a 8 bytes) | levelOffsets (int64) | segmentos
+// Con el header se valida que el archivo corresponde a la petición antes de servirlo
+// ---------------------------------------------------------------------------
+const char CACHE_MAGIC[8] = {'M', 'S', 'C', 'A', 'C', 'H', 'E', '1'};
+const uint32_t CACHE_VERSION = 1;
+
+struct CacheFileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t numIsolevels;
+    int64_t width, height;
+    uint64_t keyHi, keyLo;
+    uint64_t segmentCount;
+    uint64_t offsetsOffset;
+    uint64_t segmentsOffset;
+    uint64_t fileSize;
+};
+
+// Archivo mapeado en memoria, se desmapea en el destructor
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(void *address, std::size_t size) : address_(address), size_(size) {}
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    MappedFile(MappedFile &&other) noexcept : address_(other.address_), size_(other.size_)
+    {
+        other.address_ = nullptr;
+        other.size_ = 0;
+    }
+
+    MappedFile &operator=(MappedFile &&other) noexcept
+    {
+        std::swap(address_, other.address_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    ~MappedFile()
+    {
+        if (address_ != nullptr)
+            munmap(address_, size_);
+    }
+
+    const unsigned char *data() const { return static_cast<const unsigned char *>(address_); }
+    std::size_t size() const { return size_; }
+
+private:
+    void *address_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+// Lo que recibe quien pide un contorno: o el resultado recién calculado o el archivo mapeado
+// En ambos casos se lee con los mismos punteros
+struct ContourOutput
+{
+    ContourResult computed;
+    MappedFile mapped;
+    bool fromCache = false;
+
+    const LineSegment *segments = nullptr;
+    std::size_t count = 0;
+    const int64_t *levelOffsets = nullptr;
+};
+
+class ContourCache
+{
+public:
+    ContourCache(std::string directory, uint64_t maxBytes)
+        : directory_(std::move(directory)), maxBytes_(maxBytes)
+    {
+        std::error_code error;
+        std::filesystem::create_directories(directory_, error);
+
+        // Si el máximo bajó desde la última corrida, o quedaron temporales de un proceso que murió, se recorta ya
+        evict("");
+    }
+
+    const std::string &directory() const { return directory_; }
+
+    // nullopt si no está o si el archivo no corresponde a la petición (en ese caso se recalcula y se pisa)
+    std::optional<MappedFile> lookup(const CacheKey &key, int gridWidth, int gridHeight,
+                                     const std::vector<float> &isolevels) const
+    {
+        const std::string path = pathFor(key);
+        int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0)
+            return std::nullopt;
+
+        struct stat info;
+        if (fstat(fd, &info) != 0 || std::size_t(info.st_size) < sizeof(CacheFileHeader))
+        {
+            close(fd);
+            return std::nullopt;
+        }
+
+        void *address = mmap(nullptr, info.st_size, PROT_READ, MAP_SHARED, fd, 0);
+
+        // Para el LRU: un hit actualiza el mtime del archivo
+        if (address != MAP_FAILED)
+            futimens(fd, nullptr);
+
+        close(fd);
+
+        if (address == MAP_FAILED)
+            return std::nullopt;
+
+        MappedFile file(address, info.st_size);
+        if (!matches(file, key, gridWidth, gridHeight, isolevels))
+            return std::nullopt;
+
+        return file;
+    }
+
+    // Se escribe a un archivo temporal y se renombra, así otro proceso nunca mapea un archivo a medias
+    // Se recorta el caché en cada intento, aunque el resultado no entre o falle la escritura
+    bool store(const CacheKey &key, int gridWidth, int gridHeight,
+               const std::vector<float> &isolevels, const ContourResult &result)
+    {
+        const std::string path = pathFor(key);
+        const bool stored = writeEntry(path, key, gridWidth, gridHeight, isolevels, result);
+
+        evict(stored ? path : "");
+        return stored;
+    }
+
+private:
+    std::string directory_;
+    uint64_t maxBytes_;
+
+    std::string pathFor(const CacheKey &key) const
+    {
+        return directory_ + "/" + key.hex() + ".msc";
+    }
+
+    bool writeEntry(const std::string &path, const CacheKey &key, int gridWidth, int gridHeight,
+                    const std::vector<float> &isolevels, const ContourResult &result)
+    {
+        const uint32_t numIsolevels = (uint32_t)isolevels.size();
+
+        CacheFileHeader header = {};
+        std::memcpy(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC));
+        header.version = CACHE_VERSION;
+        header.numIsolevels = numIsolevels;
+        header.width = gridWidth;
+        header.height = gridHeight;
+        header.keyHi = key.hi;
+        header.keyLo = key.lo;
+        header.segmentCount = result.segments.size();
+        header.offsetsOffset = align8(sizeof(CacheFileHeader) + numIsolevels * sizeof(float));
+        header.segmentsOffset = header.offsetsOffset + (numIsolevels + 1) * sizeof(int64_t);
+        header.fileSize = header.segmentsOffset + result.segments.size() * sizeof(LineSegment);
+
+        if (header.fileSize > maxBytes_)
+            return false;
+
+        const std::string tempPath = path + ".tmp." + std::to_string(getpid());
+
+        int fd = open(tempPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (fd < 0)
+            return false;
+
+        const char padding[8] = {};
+        const std::size_t paddingBytes = header.offsetsOffset - (sizeof(CacheFileHeader) + numIsolevels * sizeof(float));
+
+        bool ok = writeAll(fd, &header, sizeof(header)) &&
+                  writeAll(fd, isolevels.data(), numIsolevels * sizeof(float)) &&
+                  writeAll(fd, padding, paddingBytes) &&
+                  writeAll(fd, result.levelOffsets.data(), (numIsolevels + 1) * sizeof(int64_t)) &&
+                  writeAll(fd, result.segments.data(), result.segments.size() * sizeof(LineSegment));
+
+        ok = (close(fd) == 0) && ok;
+
+        if (!ok || std::rename(tempPath.c_str(), path.c_str()) != 0)
+        {
+            unlink(tempPath.c_str());
+            return false;
+        }
+
+        return true;
+    }
+
+    static uint64_t align8(uint64_t v)
+    {
+        return (v + 7) & ~uint64_t(7);
+    }
+
+    static bool writeAll(int fd, const void *data, std::size_t size)
+    {
+        const char *bytes = static_cast<const char *>(data);
+        while (size > 0)
+        {
+            ssize_t written = write(fd, bytes, size);
+            if (written < 0)
+            {
+                if (errno == EINTR)
+                    continue;
+                return false;
+            }
+            bytes += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    static bool matches(const MappedFile &file, const CacheKey &key, int gridWidth, int gridHeight,
+                        const std::vector<float> &isolevels)
+    {
+        CacheFileHeader header;
+        std::memcpy(&header, file.data(), sizeof(header));
+
+        if (std::memcmp(header.magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 ||
+            header.version != CACHE_VERSION || header.fileSize != file.size() ||
+            header.keyHi != key.hi || header.keyLo != key.lo ||
+            header.width != gridWidth || header.height != gridHeight ||
+            header.numIsolevels != isolevels.size() ||
+            header.offsetsOffset != align8(sizeof(CacheFileHeader) + isolevels.size() * sizeof(float)) ||
+            header.segmentsOffset != header.offsetsOffset + (isolevels.size() + 1) * sizeof(int64_t) ||
+            header.segmentsOffset > header.fileSize ||
+            header.segmentCount != (header.fileSize - header.segmentsOffset) / sizeof(LineSegment) ||
+            header.segmentsOffset + header.segmentCount * sizeof(LineSegment) != header.fileSize)
+            return false;
+
+        if (std::memcmp(file.data() + sizeof(CacheFileHeader), isolevels.data(),
+                        isolevels.size() * sizeof(float)) != 0)
+            return false;
+
+        // Los offsets por isovalue se usan para indexar los segmentos: tienen que empezar en 0, no bajar y
+        // terminar en segmentCount; si no, el archivo está roto y se recalcula
+        std::vector<int64_t> levelOffsets(isolevels.size() + 1);
+        std::memcpy(levelOffsets.data(), file.data() + header.offsetsOffset, levelOffsets.size() * sizeof(int64_t));
+
+        if (levelOffsets.front() != 0 || levelOffsets.back() != (int64_t)header.segmentCount)
+            return false;
+
+        return std::is_sorted(levelOffsets.begin(), levelOffsets.end());
+    }
+
+    // Temporales <llave>.msc.tmp.<pid>: si el proceso que lo escribía ya no existe, quedó huérfano
+    static bool isTempFile(const std::string &name, pid_t &writer)
+    {
+        const std::string marker = ".msc.tmp.";
+        const std::size_t pos = name.find(marker);
+        if (pos == std::string::npos)
+            return false;
+
+        writer = (pid_t)std::atol(name.c_str() + pos + marker.size());
+        return true;
+    }
+
+    // LRU por mtime: se borran los archivos más viejos hasta quedar bajo maxBytes
+    // El archivo recién escrito nunca se borra
+    // Los temporales huérfanos se borran siempre; los de un proceso vivo cuentan en el total pero no se tocan
+    void evict(const std::string &keepPath)
+    {
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type lastUse;
+            uint64_t size;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t totalBytes = 0;
+        std::error_code error;
+
+        for (const auto &item : std::filesystem::directory_iterator(directory_, error))
+        {
+            pid_t writer = 0;
+            const bool temp = isTempFile(item.path().filename().string(), writer);
+            if (!temp && item.path().extension() != ".msc")
+                continue;
+
+            std::error_code entryError;
+            uint64_t size = item.file_size(entryError);
+            auto lastUse = item.last_write_time(entryError);
+            if (entryError)
+                continue;
+
+            if (temp)
+            {
+                if (writer <= 0 || (kill(writer, 0) != 0 && errno == ESRCH))
+                    std::filesystem::remove(item.path(), entryError);
+                else
+                    totalBytes += size;
+                continue;
+            }
+
+            entries.push_back({item.path(), lastUse, size});
+            totalBytes += size;
+        }
+
+        if (totalBytes <= maxBytes_)
+            return;
+
+        std::sort(entries.begin(), entries.end(),
+                  [](const Entry &a, const Entry &b) { return a.lastUse < b.lastUse; });
+
+        for (const Entry &entry : entries)
+        {
+            if (totalBytes <= maxBytes_)
+                break;
+
+            if (entry.path == keepPath)
+                continue;
+
+            if (std::filesystem::remove(entry.path, error))
+                totalBytes -= entry.size;
+        }
+    }
+};
+
+// Punto de entrada con caché: hit -> mmap del archivo, miss -> barrida normal y se guarda para la próxima
+ContourOutput contourCached(ContourCache &cache, const std::vector<float> &scalarField, int gridWidth, int gridHeight,
+                            const std::vector<float> &isolevels)
+{
+    ContourOutput output;
+    const CacheKey key = hashRequest(scalarField, gridWidth, gridHeight, isolevels);
+
+    if (std::optional<MappedFile> file = cache.lookup(key, gridWidth, gridHeight, isolevels))
+    {
+        CacheFileHeader header;
+        std::memcpy(&header, file->data(), sizeof(header));
+
+        output.mapped = std::move(*file);
+        output.fromCache = true;
+        output.count = header.segmentCount;
+        output.levelOffsets = reinterpret_cast<const int64_t *>(output.mapped.data() + header.offsetsOffset);
+        output.segments = reinterpret_cast<const LineSegment *>(output.mapped.data() + header.segmentsOffset);
+        return output;
+    }
+
+    output.computed = contourLevels(scalarField, gridWidth, gridHeight, isolevels);
+    cache.store(key, gridWidth, gridHeight, isolevels, output.computed);
+
+    output.count = output.computed.segments.size();
+    output.levelOffsets = output.computed.levelOffsets.data();
+    output.segments = output.computed.segments.data();
+    return output;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 4000;
+    int num_contours = 10;
+    std::string cacheDirectory = "contour_cache";
+    uint64_t maxMegabytes = 1024;
+
+    if (const char *env = std::getenv("MARCHING_CACHE_DIR"))
+        cacheDirectory = env;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: cantidad de isovalues
+    // Tercer argumento: directorio del caché (también MARCHING_CACHE_DIR)
+    // Cuarto argumento: tamaño máximo del caché en MB
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        num_contours = std::max(1, std::stoi(argv[2]));
+
+    if (argc > 3 && argv[3][0] != '\0')
+        cacheDirectory = argv[3];
+
+    if (argc > 4 && argv[4][0] != '\0')
+        maxMegabytes = std::stoull(argv[4]);
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+    std::cout << "Caché en '" << cacheDirectory << "', máximo " << maxMegabytes << " MB." << std::endl;
+
+    // Campo determinista (el radial del checkpoint 1) para que corridas distintas pidan lo mismo
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float dx = x - centerX;
+            float dy = y - centerY;
+            scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    std::vector<float> isolevels;
+    const float max_radius = gridWidth / 2.0f;
+    for (int i = 1; i <= num_contours; ++i)
+        isolevels.push_back((float(i) / num_contours) * (max_radius * 0.95f));
+
+    ContourCache cache(cacheDirectory, maxMegabytes * 1024 * 1024);
+
+    double startTime = omp_get_wtime();
+    CacheKey key = hashRequest(scalarField, gridWidth, gridHeight, isolevels);
+    double endTime = omp_get_wtime();
+
+    std::cout << "Hash del campo tomó " << (endTime - startTime) * 1000.0 << " ms (llave " << key.hex() << ")." << std::endl;
+
+    startTime = omp_get_wtime();
+    ContourResult reference = contourLevels(scalarField, gridWidth, gridHeight, isolevels);
+    endTime = omp_get_wtime();
+
+    std::cout << "Marching squares sin caché tomó " << (endTime - startTime) * 1000.0 << " ms ("
+              << reference.segments.size() << " segmentos)." << std::endl;
+
+    // La primera petición puede ser hit si una corrida anterior ya dejó el archivo
+    for (int i = 0; i < 3; ++i)
+    {
+        startTime = omp_get_wtime();
+        ContourOutput output = contourCached(cache, scalarField, gridWidth, gridHeight, isolevels);
+        endTime = omp_get_wtime();
+
+        bool same = output.count == reference.segments.size() &&
+                    std::equal(output.levelOffsets, output.levelOffsets + isolevels.size() + 1, reference.levelOffsets.begin()) &&
+                    std::memcmp(output.segments, reference.segments.data(), output.count * sizeof(LineSegment)) == 0;
+
+        std::cout << "Petición " << i + 1 << " (" << (output.fromCache ? "hit, mmap" : "miss, barrida")
+                  << ") tomó " << (endTime - startTime) * 1000.0 << " ms, " << output.count << " segmentos"
+                  << (same ? "." : ", NO coincide con la barrida sin caché.") << std::endl;
+    }
+
+    return 0;
+}
@@ -13,9 +13,10 @@ def parse_results(filename):
             if match:
                 size, threads = int(match.group(1)), int(match.group(2))
             else:
-                if size is not None and threads is not None:
-                    t = float(line.replace('ms.', '').replace('ms', '').strip())
-                    results[(size, threads)].append(t)
+                # Las líneas de memoria que siguen a los tiempos se ignoran
+                time_match = re.match(r'([\d.]+)\s*ms', line)
+                if size is not None and threads is not None and time_match:
+                    results[(size, threads)].append(float(time_match.group(1)))
     return results
 
 def compute_speedup_efficiency(results):
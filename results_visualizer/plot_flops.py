@@ -1,12 +1,39 @@
+import os
 import re
 import numpy as np
 import pandas as pd
 import plotly.graph_objects as go
 
+from plot_roofline import parse_roofline
+
+# Estimación analítica de antes, se usa si no hay roofline.txt
 FLOPS_PER_CELL = 23.5
 
+# Variante y campo de la suite que corresponden a resultados_opt_new.txt
+ROOFLINE_VARIANT = "arena"
+ROOFLINE_FIELD = "binary"
+
+
+def measured_flops_per_cell(path: str) -> float:
+    # roofline.txt es un refinamiento opcional: sin él (o sin la variante) queda la estimación analítica
+    if not os.path.exists(path):
+        print(f"No existe {path}, se usan {FLOPS_PER_CELL} flops por celda (estimación analítica).")
+        print("Para medirlos, corre variant_suite en modo roofline y copia roofline.txt aquí.")
+        return FLOPS_PER_CELL
+
+    _, runs = parse_roofline(path)
+    runs = runs[(runs["variant"] == ROOFLINE_VARIANT) & (runs["field"] == ROOFLINE_FIELD)]
+    if runs.empty:
+        print(
+            f"{path} no tiene la variante {ROOFLINE_VARIANT} con el campo {ROOFLINE_FIELD}, "
+            f"se usan {FLOPS_PER_CELL} flops por celda (estimación analítica)."
+        )
+        return FLOPS_PER_CELL
+
+    return float((runs["flops"] / runs["cells"]).mean())
+
 
-def parse_results(path: str) -> pd.DataFrame:
+def parse_results(path: str, flops_per_cell: float) -> pd.DataFrame:
     rows, res, thr, times = [], None, None, []
 
     with open(path, encoding="utf-8") as fh:
@@ -16,7 +43,7 @@ def parse_results(path: str) -> pd.DataFrame:
 
             if line.startswith("["):
                 if res is not None and times:
-                    rows.append(_row(res, thr, times))
+                    rows.append(_row(res, thr, times, flops_per_cell))
                 m = re.match(r"\[(\d+),\s*(\d+)\]", line)
                 if not m:
                     raise ValueError(f"Bad header: {line}")
@@ -28,15 +55,15 @@ def parse_results(path: str) -> pd.DataFrame:
                     times.append(float(m.group(1)))
 
     if res is not None and times:
-        rows.append(_row(res, thr, times))
+        rows.append(_row(res, thr, times, flops_per_cell))
 
     return pd.DataFrame(rows)
 
 
-def _row(resolution: int, threads: int, times_ms: list[float]) -> dict:
+def _row(resolution: int, threads: int, times_ms: list[float], flops_per_cell: float) -> dict:
     avg_ms = float(np.mean(times_ms))
     cells = (resolution - 1) ** 2
-    flops = cells * FLOPS_PER_CELL
+    flops = cells * flops_per_cell
     gflops = flops / (avg_ms * 1e-3) / 1e9
     return {
         "resolution": resolution,
@@ -72,7 +99,9 @@ def build_surface(df: pd.DataFrame):
 
 
 def main():
-    df_opt = parse_results("resultados_opt_new.txt")
+    # Flops por celda medidos por variant_suite (./suite N reps semilla roofline), si está roofline.txt
+    flops_per_cell = measured_flops_per_cell("roofline.txt")
+    df_opt = parse_results("resultados_opt_new.txt", flops_per_cell)
     surf, pts = build_surface(df_opt)
 
     fig = go.Figure(data=[surf, pts])
@@ -0,0 +1,95 @@
+import numpy as np
+import pandas as pd
+import plotly.graph_objects as go
+
+
+def parse_roofline(path: str) -> tuple[pd.DataFrame, pd.DataFrame]:
+    machine, runs = [], []
+
+    with open(path, encoding="utf-8") as fh:
+        for line in map(str.strip, fh):
+            if not line:
+                continue
+
+            kind, *fields = line.split(",")
+            if fields[0] in ("hilos", "campo"):
+                continue
+
+            if kind == "maquina":
+                threads, bandwidth, peak = fields
+                machine.append(
+                    {
+                        "threads": int(threads),
+                        "bandwidth_gbs": float(bandwidth),
+                        "peak_gflops": float(peak),
+                    }
+                )
+            elif kind == "variante":
+                name, field, threads, res, ms, cells, segs, lerps, flops, nbytes = fields
+                seconds = float(ms) * 1e-3
+                runs.append(
+                    {
+                        "variant": name,
+                        "field": field,
+                        "threads": int(threads),
+                        "resolution": int(res),
+                        "avg_ms": float(ms),
+                        "cells": float(cells),
+                        "lerps": float(lerps),
+                        "flops": float(flops),
+                        "bytes": float(nbytes),
+                        "intensity": float(flops) / float(nbytes),
+                        "gflops": float(flops) / seconds / 1e9,
+                    }
+                )
+
+    return pd.DataFrame(machine), pd.DataFrame(runs)
+
+
+def build_roofline(machine: pd.DataFrame, runs: pd.DataFrame) -> go.Figure:
+    fig = go.Figure()
+    x = np.logspace(-2, 2, 200)
+
+    for _, row in machine.iterrows():
+        roof = np.minimum(row["peak_gflops"], row["bandwidth_gbs"] * x)
+        fig.add_trace(
+            go.Scatter(
+                x=x,
+                y=roof,
+                mode="lines",
+                line=dict(dash="dash"),
+                name=f"Techo {row['threads']} hilos",
+            )
+        )
+
+    for (variant, field), df in runs.groupby(["variant", "field"]):
+        fig.add_trace(
+            go.Scatter(
+                x=df["intensity"],
+                y=df["gflops"],
+                mode="markers+text",
+                text=df["threads"].astype(str),
+                textposition="top center",
+                marker=dict(size=9),
+                name=f"{variant} ({field})",
+            )
+        )
+
+    fig.update_layout(
+        title="Roofline de Marching Squares",
+        xaxis=dict(title="Intensidad aritmética (flop/byte)", type="log"),
+        yaxis=dict(title="GFLOP/s", type="log"),
+        height=700,
+    )
+    return fig
+
+
+def main():
+    machine, runs = parse_roofline("roofline.txt")
+    fig = build_roofline(machine, runs)
+    # fig.show()
+    fig.write_html("marching_squares_roofline.html", include_plotlyjs="cdn")
+
+
+if __name__ == "__main__":
+    main()
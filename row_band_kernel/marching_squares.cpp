@@ -0,0 +1,293 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Hook de variant_suite para contar las llamadas a lerp; queda vacío al compilar esta carpeta sola
+#ifndef MARCHING_COUNT_LERP
+#define MARCHING_COUNT_LERP(degenerate)
+#endif
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+    MARCHING_COUNT_LERP(std::fabs(denom) < EPS);
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// Una fila de celdas con el sliding window del checkpoint 5
+void marchRow(const float *scalarField, int gridWidth, int y, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// Banda de K filas de celdas en un solo barrido
+// En cada columna se cargan las K + 1 muestras una sola vez y se guardan en registros (col)
+// La columna anterior (prev) es el lado izquierdo de las K celdas, así cada muestra de la banda
+// se lee de memoria una sola vez en lugar de dos (como fila de abajo y luego como fila de arriba)
+template <int K>
+void marchBand(const float *scalarField, int gridWidth, int y0, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *base = scalarField + std::size_t(y0) * gridWidth;
+
+    float prev[K + 1];
+    for (int r = 0; r <= K; ++r)
+        prev[r] = base[std::size_t(r) * gridWidth];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float col[K + 1];
+        for (int r = 0; r <= K; ++r)
+            col[r] = base[std::size_t(r) * gridWidth + (x + 1)];
+
+        for (int r = 0; r < K; ++r)
+        {
+            float values[4] = {
+                prev[r],
+                col[r],
+                col[r + 1],
+                prev[r + 1]
+            };
+
+            marchSquare((float)x, (float)(y0 + r), values, isolevel, out);
+        }
+
+        for (int r = 0; r <= K; ++r)
+            prev[r] = col[r];
+    }
+}
+
+// Cada hilo recibe un bloque contiguo de bandas (schedule static), así las filas compartidas
+// entre bandas vecinas casi siempre quedan en el mismo hilo
+template <int K>
+std::vector<LineSegment> contourBands(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    const int cellRows = gridHeight - 1;
+    const int fullBands = cellRows / K;
+
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait schedule(static)
+        for (int b = 0; b < fullBands; ++b)
+            marchBand<K>(scalarField.data(), gridWidth, b * K, isolevel, privateSegments);
+
+        // Las filas que sobran al final (menos de K) se hacen fila por fila
+        #pragma omp for nowait schedule(static)
+        for (int y = fullBands * K; y < cellRows; ++y)
+            marchRow(scalarField.data(), gridWidth, y, isolevel, privateSegments);
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// El kernel del checkpoint 5, como referencia
+std::vector<LineSegment> contourRows(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+            marchRow(scalarField.data(), gridWidth, y, isolevel, privateSegments);
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+// K se fija en compilación para que las columnas queden en registros
+std::vector<LineSegment> contourBandsDispatch(int bandRows, const std::vector<float> &scalarField,
+                                              int gridWidth, int gridHeight, float isolevel)
+{
+    switch (bandRows)
+    {
+    case 2:
+        return contourBands<2>(scalarField, gridWidth, gridHeight, isolevel);
+    case 4:
+        return contourBands<4>(scalarField, gridWidth, gridHeight, isolevel);
+    case 16:
+        return contourBands<16>(scalarField, gridWidth, gridHeight, isolevel);
+    default:
+        return contourBands<8>(scalarField, gridWidth, gridHeight, isolevel);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 100;
+    int bandRows = 8;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: filas por banda (2, 4, 8 o 16)
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        bandRows = std::stoi(argv[2]);
+
+    if (bandRows != 2 && bandRows != 4 && bandRows != 16)
+        bandRows = 8;
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+
+    std::srand(static_cast<unsigned int>(std::time(nullptr)));
+
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            scalarField[std::size_t(y) * gridWidth + x] = std::rand() % 2;
+        }
+    }
+
+    for (int i = 0; i < 5; ++i)
+    {
+        double startTime = omp_get_wtime();
+        std::vector<LineSegment> rowSegments = contourRows(scalarField, gridWidth, gridHeight, isolevel);
+        double rowMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        startTime = omp_get_wtime();
+        std::vector<LineSegment> bandSegments = contourBandsDispatch(bandRows, scalarField, gridWidth, gridHeight, isolevel);
+        double bandMs = (omp_get_wtime() - startTime) * 1000.0;
+
+        std::cout << "Filas: " << rowMs << " ms (" << rowSegments.size() << " segmentos), bandas de "
+                  << bandRows << ": " << bandMs << " ms (" << bandSegments.size() << " segmentos)." << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,64 @@
+import sys
+import time
+
+import numpy as np
+
+import marchingsquares
+
+
+def radial_field(resolution):
+    # El mismo campo del checkpoint 1: distancia al centro de la malla
+    coords = np.arange(resolution, dtype=np.float32) - resolution / 2.0
+    return np.sqrt(coords[None, :] ** 2 + coords[:, None] ** 2).astype(np.float32)
+
+
+def plot_segments(segments, output_filename="contour_plot.png"):
+    # matplotlib solo hace falta para el plot
+    import matplotlib.pyplot as plt
+    from matplotlib.collections import LineCollection
+
+    fig, ax = plt.subplots(figsize=(10, 10))
+
+    # LineCollection acepta el arreglo (n, 2, 2) directamente
+    ax.add_collection(LineCollection(segments, colors="white", linewidths=0.1))
+
+    ax.set_title("Marching Squares")
+    ax.set_facecolor("black")
+    fig.set_facecolor("black")
+    ax.title.set_color("white")
+    ax.tick_params(axis="x", colors="white")
+    ax.tick_params(axis="y", colors="white")
+
+    ax.autoscale()
+    ax.set_aspect("equal", adjustable="box")
+
+    plt.savefig(output_filename, dpi=300)
+    print(f"Plot guardado en '{output_filename}'")
+
+
+if __name__ == "__main__":
+    resolution = int(sys.argv[1]) if len(sys.argv) > 1 else 1000
+    num_contours = int(sys.argv[2]) if len(sys.argv) > 2 else 10
+    plot = len(sys.argv) > 3 and sys.argv[3] == "plot"
+
+    print(f"libmarchingsquares {marchingsquares.version()}")
+    print(f"Resolución de la malla: {resolution}x{resolution}")
+
+    field = radial_field(resolution)
+    max_radius = resolution / 2.0
+    isolevels = [(i / num_contours) * max_radius * 0.95 for i in range(1, num_contours + 1)]
+
+    start = time.perf_counter()
+    segments, offsets = marchingsquares.contour(field, isolevels)
+    elapsed = (time.perf_counter() - start) * 1000.0
+
+    print(f"Marching squares tomó {elapsed} ms.")
+    print(f"Se generó {len(segments)} segmentos de línea para {len(isolevels)} isovalues.")
+
+    # Una ventana de la malla se pasa con su stride, tampoco se copia
+    window = field[: resolution // 2, : resolution // 2]
+    window_segments, _ = marchingsquares.contour(window, isolevels)
+    print(f"Ventana {window.shape[1]}x{window.shape[0]}: {len(window_segments)} segmentos.")
+
+    if plot:
+        plot_segments(segments)
@@ -0,0 +1,278 @@
+#include "marching_squares.h"
+
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <new>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+static_assert(sizeof(LineSegment) == 4 * sizeof(float), "LineSegment se expone como 4 floats");
+
+// Resultado opaco del ABI: los segmentos viven aquí hasta ms_result_free
+struct ms_result
+{
+    std::vector<LineSegment> segments;
+    std::vector<int64_t> levelOffsets;
+};
+
+// Cada hilo guarda sus segmentos separados por isovalue
+// Después se calcula dónde va cada bloque (isovalue, hilo) y se copian en paralelo a un solo buffer.
+// Devuelve false si algún hilo se quedó sin memoria: un bad_alloc no puede salir de la región paralela
+// (sería std::terminate), así que se atrapa por fila y se avisa con una bandera compartida
+static bool contourInto(const float *data, int width, int height, int64_t stride,
+                        const float *isolevels, int numIsolevels, ms_result &result)
+{
+    const int numThreads = omp_get_max_threads();
+    std::vector<std::vector<std::vector<LineSegment>>> threadSegments(
+        numThreads, std::vector<std::vector<LineSegment>>(numIsolevels));
+    bool outOfMemory = false;
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        auto &mySegments = threadSegments[omp_get_thread_num()];
+
+        for (int level = 0; level < numIsolevels; ++level)
+        {
+            const float isolevel = isolevels[level];
+            std::vector<LineSegment> &out = mySegments[level];
+
+            #pragma omp for nowait schedule(static)
+            for (int y = 0; y < height - 1; ++y)
+            {
+                bool failed;
+                #pragma omp atomic read
+                failed = outOfMemory;
+                if (failed)
+                    continue;
+
+                const float *top = data + y * stride;
+                const float *bottom = top + stride;
+
+                float left_top_val = top[0];
+                float left_bottom_val = bottom[0];
+
+                try
+                {
+                    for (int x = 0; x < width - 1; ++x)
+                    {
+                        float right_top_val = top[x + 1];
+                        float right_bottom_val = bottom[x + 1];
+
+                        float values[4] = {
+                            left_top_val,
+                            right_top_val,
+                            right_bottom_val,
+                            left_bottom_val
+                        };
+
+                        marchSquare((float)x, (float)y, values, isolevel, out);
+
+                        left_top_val = right_top_val;
+                        left_bottom_val = right_bottom_val;
+                    }
+                }
+                catch (const std::bad_alloc &)
+                {
+                    #pragma omp atomic write
+                    outOfMemory = true;
+                }
+            }
+        }
+    }
+
+    if (outOfMemory)
+        return false;
+
+    // Offsets de cada bloque en orden isovalue -> hilo, así el resultado queda agrupado por isovalue
+    std::vector<std::size_t> blockOffsets(std::size_t(numIsolevels) * numThreads + 1, 0);
+    result.levelOffsets.assign(numIsolevels + 1, 0);
+
+    for (int level = 0; level < numIsolevels; ++level)
+    {
+        for (int t = 0; t < numThreads; ++t)
+        {
+            std::size_t block = std::size_t(level) * numThreads + t;
+            blockOffsets[block + 1] = blockOffsets[block] + threadSegments[t][level].size();
+        }
+        result.levelOffsets[level + 1] = (int64_t)blockOffsets[std::size_t(level + 1) * numThreads];
+    }
+
+    result.segments.resize(blockOffsets.back());
+
+    #pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int t = 0; t < numThreads; ++t)
+    {
+        for (int level = 0; level < numIsolevels; ++level)
+        {
+            const std::vector<LineSegment> &block = threadSegments[t][level];
+            std::copy(block.begin(), block.end(),
+                      result.segments.begin() + blockOffsets[std::size_t(level) * numThreads + t]);
+        }
+    }
+
+    return true;
+}
+
+// ---------------------------------------------------------------------------
+// ABI en C
+// Ninguna excepción cruza la frontera: las de adentro de las regiones paralelas las atrapa contourInto y
+// las reservas de afuera se atrapan acá; todas terminan en MS_ERROR_MEMORY
+// ---------------------------------------------------------------------------
+extern "C" int ms_contour(const float *data, int64_t width, int64_t height, int64_t stride,
+                          const float *isolevels, int64_t num_isolevels,
+                          ms_result **out)
+{
+    if (out == nullptr)
+        return MS_ERROR_ARGUMENTS;
+
+    *out = nullptr;
+
+    if (data == nullptr || width < 2 || height < 2 || stride < width ||
+        width > INT32_MAX || height > INT32_MAX ||
+        num_isolevels < 0 || num_isolevels > INT32_MAX ||
+        (num_isolevels > 0 && isolevels == nullptr))
+        return MS_ERROR_ARGUMENTS;
+
+    ms_result *result = new (std::nothrow) ms_result;
+    if (result == nullptr)
+        return MS_ERROR_MEMORY;
+
+    bool completed = false;
+    try
+    {
+        completed = contourInto(data, (int)width, (int)height, stride, isolevels, (int)num_isolevels, *result);
+    }
+    catch (const std::bad_alloc &)
+    {
+    }
+
+    if (!completed)
+    {
+        delete result;
+        return MS_ERROR_MEMORY;
+    }
+
+    *out = result;
+    return MS_OK;
+}
+
+extern "C" int64_t ms_result_count(const ms_result *result)
+{
+    return result == nullptr ? 0 : (int64_t)result->segments.size();
+}
+
+extern "C" const float *ms_result_segments(const ms_result *result)
+{
+    if (result == nullptr || result->segments.empty())
+        return nullptr;
+
+    return &result->segments[0].start.x;
+}
+
+extern "C" const int64_t *ms_result_level_offsets(const ms_result *result)
+{
+    return result == nullptr ? nullptr : result->levelOffsets.data();
+}
+
+extern "C" void ms_result_free(ms_result *result)
+{
+    delete result;
+}
+
+extern "C" const char *ms_version(void)
+{
+    return "1.0";
+}
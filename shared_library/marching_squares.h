@@ -0,0 +1,47 @@
+#ifndef MARCHING_SQUARES_H
+#define MARCHING_SQUARES_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// ABI en C de libmarchingsquares.so
+// Los segmentos se devuelven como floats x0, y0, x1, y1 en un buffer de la biblioteca
+// que el llamador lee directamente (sin copias) hasta llamar a ms_result_free
+
+#define MS_OK 0
+#define MS_ERROR_ARGUMENTS -1
+#define MS_ERROR_MEMORY -2
+
+// La biblioteca se compila con -fvisibility=hidden, solo estas funciones se exportan
+#define MS_API __attribute__((visibility("default")))
+
+typedef struct ms_result ms_result;
+
+// data: primera muestra del campo, la muestra (x, y) está en data[y * stride + x]
+// stride: distancia entre filas en floats (>= width), permite pasar una ventana de una malla más grande
+// Los segmentos quedan agrupados por isovalue en el orden de isolevels
+MS_API int ms_contour(const float *data, int64_t width, int64_t height, int64_t stride,
+               const float *isolevels, int64_t num_isolevels,
+               ms_result **out);
+
+// Cantidad total de segmentos
+MS_API int64_t ms_result_count(const ms_result *result);
+
+// count * 4 floats: x0, y0, x1, y1 por segmento
+MS_API const float *ms_result_segments(const ms_result *result);
+
+// num_isolevels + 1 offsets: los segmentos del isovalue i son [offsets[i], offsets[i + 1])
+MS_API const int64_t *ms_result_level_offsets(const ms_result *result);
+
+MS_API void ms_result_free(ms_result *result);
+
+MS_API const char *ms_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
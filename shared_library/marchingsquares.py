@@ -0,0 +1,150 @@
+"""Wrapper de ctypes para libmarchingsquares.so.
+
+El campo se pasa como puntero directo al buffer de NumPy y los segmentos se
+devuelven como arreglos de NumPy sobre la memoria de la biblioteca, sin copias
+ni CSV de por medio. La memoria se libera cuando ya no queda ningún arreglo
+que la use.
+"""
+
+import ctypes
+import os
+
+import numpy as np
+
+MS_OK = 0
+MS_ERROR_ARGUMENTS = -1
+MS_ERROR_MEMORY = -2
+
+_LIBRARY_NAME = "libmarchingsquares.so"
+
+
+def _load_library():
+    path = os.environ.get(
+        "MARCHING_SQUARES_LIB",
+        os.path.join(os.path.dirname(os.path.abspath(__file__)), _LIBRARY_NAME),
+    )
+    lib = ctypes.CDLL(path)
+
+    lib.ms_contour.restype = ctypes.c_int
+    lib.ms_contour.argtypes = [
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int64,
+        ctypes.c_int64,
+        ctypes.c_int64,
+        ctypes.POINTER(ctypes.c_float),
+        ctypes.c_int64,
+        ctypes.POINTER(ctypes.c_void_p),
+    ]
+    lib.ms_result_count.restype = ctypes.c_int64
+    lib.ms_result_count.argtypes = [ctypes.c_void_p]
+    lib.ms_result_segments.restype = ctypes.c_void_p
+    lib.ms_result_segments.argtypes = [ctypes.c_void_p]
+    lib.ms_result_level_offsets.restype = ctypes.c_void_p
+    lib.ms_result_level_offsets.argtypes = [ctypes.c_void_p]
+    lib.ms_result_free.restype = None
+    lib.ms_result_free.argtypes = [ctypes.c_void_p]
+    lib.ms_version.restype = ctypes.c_char_p
+    lib.ms_version.argtypes = []
+
+    return lib
+
+
+_lib = _load_library()
+
+
+class _Result:
+    """Dueño del ms_result de C; se libera cuando el último arreglo lo suelta."""
+
+    def __init__(self, handle):
+        self.handle = handle
+
+    def __del__(self):
+        if self.handle:
+            _lib.ms_result_free(self.handle)
+            self.handle = None
+
+
+class _View:
+    """Expone un buffer de la biblioteca con __array_interface__ y mantiene vivo al dueño."""
+
+    def __init__(self, owner, pointer, shape, typestr):
+        self._owner = owner
+        self.__array_interface__ = {
+            "shape": shape,
+            "typestr": typestr,
+            "data": (pointer or 0, True),
+            "version": 3,
+        }
+
+
+def _as_float32_field(field):
+    """Devuelve (arreglo, stride en floats) sin copiar si el layout ya sirve."""
+    field = np.asarray(field)
+
+    if field.ndim != 2:
+        raise ValueError("El campo debe ser un arreglo 2D (alto, ancho)")
+
+    item = np.dtype(np.float32).itemsize
+    usable = (
+        field.dtype == np.float32
+        and field.strides[1] == item
+        and field.strides[0] % item == 0
+        and field.strides[0] >= field.shape[1] * item
+    )
+
+    # Otro dtype o columnas no contiguas: aquí sí hay una copia
+    if not usable:
+        field = np.ascontiguousarray(field, dtype=np.float32)
+
+    return field, field.strides[0] // item
+
+
+def contour(field, isolevels):
+    """Calcula los contornos de `field` para uno o varios isovalues.
+
+    Devuelve (segments, level_offsets):
+      - segments: arreglo float32 (n, 2, 2) con [[x0, y0], [x1, y1]] por segmento
+      - level_offsets: arreglo int64 (len(isolevels) + 1,); los segmentos del
+        isovalue i son segments[level_offsets[i]:level_offsets[i + 1]]
+    """
+    field, stride = _as_float32_field(field)
+    levels = np.ascontiguousarray(np.atleast_1d(isolevels), dtype=np.float32)
+    height, width = field.shape
+
+    handle = ctypes.c_void_p()
+    status = _lib.ms_contour(
+        field.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+        width,
+        height,
+        stride,
+        levels.ctypes.data_as(ctypes.POINTER(ctypes.c_float)),
+        levels.size,
+        ctypes.byref(handle),
+    )
+
+    if status == MS_ERROR_MEMORY:
+        raise MemoryError("libmarchingsquares se quedó sin memoria")
+    if status != MS_OK:
+        raise ValueError(f"Argumentos inválidos para ms_contour (código {status})")
+
+    owner = _Result(handle.value)
+    count = _lib.ms_result_count(owner.handle)
+
+    segments = np.asarray(
+        _View(owner, _lib.ms_result_segments(owner.handle), (count, 2, 2), "<f4")
+    )
+    level_offsets = np.asarray(
+        _View(owner, _lib.ms_result_level_offsets(owner.handle), (levels.size + 1,), "<i8")
+    )
+
+    return segments, level_offsets
+
+
+def contour_levels(field, isolevels):
+    """Igual que contour, pero devuelve una lista con los segmentos de cada isovalue (vistas, sin copias)."""
+    segments, offsets = contour(field, isolevels)
+    return [segments[offsets[i] : offsets[i + 1]] for i in range(len(offsets) - 1)]
+
+
+def version():
+    return _lib.ms_version().decode()
@@ -0,0 +1,20 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+LIBRARY_NAME="libmarchingsquares.so"
+PYTHON_SCRIPT="example.py"
+
+if [ -n "$4" ]; then
+  export OMP_NUM_THREADS=$4
+fi
+
+echo "Compilando la biblioteca: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp -shared -fPIC -fvisibility=hidden "$CPP_SOURCE" -o "$LIBRARY_NAME" -std=c++17
+echo "Compilación exitosa. Biblioteca creada: $LIBRARY_NAME"
+echo ""
+
+echo "Corriendo el ejemplo: $PYTHON_SCRIPT..."
+python3 "$PYTHON_SCRIPT" "$1" "$2" "$3"
+echo ""
+
+echo "Proceso completado."
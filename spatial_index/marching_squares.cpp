@@ -0,0 +1,499 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <random>
+#include <limits>
+#include <iostream>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// ---------------------------------------------------------------------------
+// Índice espacial
+// La malla se parte en buckets de tileSize x tileSize celdas. Cada iteración del loop paralelo es una
+// banda de tileSize filas que se recorre bucket por bucket (izquierda a derecha), así los segmentos de
+// un bucket salen juntos y el índice es solo un contador por bucket. Después se hace el prefix sum y
+// cada banda copia lo suyo, igual que en batched_contouring.
+// Los segmentos del bucket (tx, ty) son segments[tileOffsets[b], tileOffsets[b + 1]) con b = ty * tilesX + tx
+// ---------------------------------------------------------------------------
+struct SegmentIndex
+{
+    std::vector<LineSegment> segments;
+    std::vector<std::size_t> tileOffsets;
+    int tileSize;
+    int tilesX, tilesY;
+};
+
+SegmentIndex contourIndexed(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel, int tileSize)
+{
+    SegmentIndex index;
+    index.tileSize = tileSize;
+    index.tilesX = (gridWidth - 1 + tileSize - 1) / tileSize;
+    index.tilesY = (gridHeight - 1 + tileSize - 1) / tileSize;
+
+    const int numBands = index.tilesY;
+    std::vector<std::vector<LineSegment>> bandSegments(numBands);
+    // Primero el tamaño de cada bucket, después el prefix sum lo convierte en offsets
+    index.tileOffsets.assign(std::size_t(index.tilesX) * index.tilesY + 1, 0);
+
+    #pragma omp parallel
+    {
+        #pragma omp for schedule(static)
+        for (int band = 0; band < numBands; ++band)
+        {
+            std::vector<LineSegment> &out = bandSegments[band];
+            const int y0 = band * tileSize;
+            const int y1 = std::min(gridHeight - 1, y0 + tileSize);
+
+            for (int tx = 0; tx < index.tilesX; ++tx)
+            {
+                const int x0 = tx * tileSize;
+                const int x1 = std::min(gridWidth - 1, x0 + tileSize);
+                const std::size_t before = out.size();
+
+                for (int y = y0; y < y1; ++y)
+                {
+                    const float *top = scalarField.data() + std::size_t(y) * gridWidth;
+                    const float *bottom = top + gridWidth;
+
+                    float left_top_val = top[x0];
+                    float left_bottom_val = bottom[x0];
+
+                    for (int x = x0; x < x1; ++x)
+                    {
+                        float right_top_val = top[x + 1];
+                        float right_bottom_val = bottom[x + 1];
+
+                        float values[4] = {
+                            left_top_val,
+                            right_top_val,
+                            right_bottom_val,
+                            left_bottom_val
+                        };
+
+                        marchSquare((float)x, (float)y, values, isolevel, out);
+
+                        left_top_val = right_top_val;
+                        left_bottom_val = right_bottom_val;
+                    }
+                }
+
+                index.tileOffsets[std::size_t(band) * index.tilesX + tx + 1] = out.size() - before;
+            }
+        }
+
+        // El omp for termina con barrera: ya se conocen todos los tamaños
+        #pragma omp single
+        {
+            for (std::size_t b = 1; b < index.tileOffsets.size(); ++b)
+                index.tileOffsets[b] += index.tileOffsets[b - 1];
+
+            index.segments.resize(index.tileOffsets.back());
+        }
+
+        #pragma omp for schedule(static)
+        for (int band = 0; band < numBands; ++band)
+        {
+            std::copy(bandSegments[band].begin(), bandSegments[band].end(),
+                      index.segments.begin() + index.tileOffsets[std::size_t(band) * index.tilesX]);
+            std::vector<LineSegment>().swap(bandSegments[band]);
+        }
+    }
+
+    return index;
+}
+
+// Caja en coordenadas de la malla (x hacia la derecha, y hacia abajo, como las celdas)
+struct Box
+{
+    float minX, minY, maxX, maxY;
+};
+
+bool overlaps(const LineSegment &segment, const Box &box)
+{
+    return std::max(segment.start.x, segment.end.x) >= box.minX && std::min(segment.start.x, segment.end.x) <= box.maxX &&
+           std::max(segment.start.y, segment.end.y) >= box.minY && std::min(segment.start.y, segment.end.y) <= box.maxY;
+}
+
+float distanceSquared(const LineSegment &segment, Point p)
+{
+    const float dx = segment.end.x - segment.start.x;
+    const float dy = segment.end.y - segment.start.y;
+    const float length = dx * dx + dy * dy;
+
+    float t = length > EPS ? ((p.x - segment.start.x) * dx + (p.y - segment.start.y) * dy) / length : 0.0f;
+    t = std::min(1.0f, std::max(0.0f, t));
+
+    const float ex = segment.start.x + t * dx - p.x;
+    const float ey = segment.start.y + t * dy - p.y;
+    return ex * ex + ey * ey;
+}
+
+// Segmentos cuya caja toca la caja pedida: solo se revisan los buckets que la cubren
+// Un segmento de la celda (x, y) no sale de [x, x + 1] x [y, y + 1], así que el bucket lo contiene entero
+void queryRange(const SegmentIndex &index, const Box &box, std::vector<std::size_t> &result)
+{
+    result.clear();
+
+    // El bucket b cubre [b * T, (b + 1) * T]: toca la caja si (b + 1) * T >= min y b * T <= max
+    const float T = (float)index.tileSize;
+    const int tx0 = std::max(0, (int)std::ceil(box.minX / T) - 1);
+    const int ty0 = std::max(0, (int)std::ceil(box.minY / T) - 1);
+    const int tx1 = std::min(index.tilesX - 1, (int)std::floor(box.maxX / T));
+    const int ty1 = std::min(index.tilesY - 1, (int)std::floor(box.maxY / T));
+
+    for (int ty = ty0; ty <= ty1; ++ty)
+    {
+        for (int tx = tx0; tx <= tx1; ++tx)
+        {
+            const std::size_t b = std::size_t(ty) * index.tilesX + tx;
+
+            for (std::size_t s = index.tileOffsets[b]; s < index.tileOffsets[b + 1]; ++s)
+                if (overlaps(index.segments[s], box))
+                    result.push_back(s);
+        }
+    }
+}
+
+// Segmento más cercano a p (el índice en index.segments), buscando en anillos de buckets alrededor de p
+// Se para cuando el mejor encontrado está más cerca que cualquier bucket fuera de los anillos revisados
+std::size_t queryNearest(const SegmentIndex &index, Point p, float &bestDistance)
+{
+    const float T = (float)index.tileSize;
+    const int cx = std::min(index.tilesX - 1, std::max(0, (int)std::floor(p.x / T)));
+    const int cy = std::min(index.tilesY - 1, std::max(0, (int)std::floor(p.y / T)));
+
+    std::size_t best = std::numeric_limits<std::size_t>::max();
+    float bestSquared = std::numeric_limits<float>::infinity();
+
+    auto scanTile = [&](int tx, int ty) {
+        if (tx < 0 || ty < 0 || tx >= index.tilesX || ty >= index.tilesY)
+            return;
+
+        const std::size_t b = std::size_t(ty) * index.tilesX + tx;
+        for (std::size_t s = index.tileOffsets[b]; s < index.tileOffsets[b + 1]; ++s)
+        {
+            float d = distanceSquared(index.segments[s], p);
+            if (d < bestSquared)
+            {
+                bestSquared = d;
+                best = s;
+            }
+        }
+    };
+
+    const int maxRing = std::max(index.tilesX, index.tilesY);
+
+    for (int r = 0; r <= maxRing; ++r)
+    {
+        if (r == 0)
+        {
+            scanTile(cx, cy);
+        }
+        else
+        {
+            for (int tx = cx - r; tx <= cx + r; ++tx)
+            {
+                scanTile(tx, cy - r);
+                scanTile(tx, cy + r);
+            }
+            for (int ty = cy - r + 1; ty <= cy + r - 1; ++ty)
+            {
+                scanTile(cx - r, ty);
+                scanTile(cx + r, ty);
+            }
+        }
+
+        // Distancia de p al borde del cuadrado de buckets ya revisado: nada afuera puede estar más cerca
+        const float reach = std::min(std::min(p.x - (cx - r) * T, (cx + r + 1) * T - p.x),
+                                     std::min(p.y - (cy - r) * T, (cy + r + 1) * T - p.y));
+
+        if (best != std::numeric_limits<std::size_t>::max() && reach > 0.0f && bestSquared <= reach * reach)
+            break;
+    }
+
+    bestDistance = std::sqrt(bestSquared);
+    return best;
+}
+
+// ---------------------------------------------------------------------------
+// Lo que se hace hoy: marching por filas y búsquedas lineales sobre allSegments
+// ---------------------------------------------------------------------------
+std::vector<LineSegment> contourRows(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+        {
+            const float *top = scalarField.data() + std::size_t(y) * gridWidth;
+            const float *bottom = top + gridWidth;
+
+            float left_top_val = top[0];
+            float left_bottom_val = bottom[0];
+
+            for (int x = 0; x < gridWidth - 1; ++x)
+            {
+                float right_top_val = top[x + 1];
+                float right_bottom_val = bottom[x + 1];
+
+                float values[4] = {
+                    left_top_val,
+                    right_top_val,
+                    right_bottom_val,
+                    left_bottom_val
+                };
+
+                marchSquare((float)x, (float)y, values, isolevel, privateSegments);
+
+                left_top_val = right_top_val;
+                left_bottom_val = right_bottom_val;
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    return allSegments;
+}
+
+std::size_t linearRangeCount(const std::vector<LineSegment> &segments, const Box &box)
+{
+    std::size_t count = 0;
+    for (const LineSegment &segment : segments)
+        count += overlaps(segment, box);
+    return count;
+}
+
+float linearNearest(const std::vector<LineSegment> &segments, Point p)
+{
+    float best = std::numeric_limits<float>::infinity();
+    for (const LineSegment &segment : segments)
+        best = std::min(best, distanceSquared(segment, p));
+    return std::sqrt(best);
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 2000;
+    int tileSize = 32;
+    int numQueries = 200;
+    std::string fieldName = "binary";
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: tamaño del bucket en celdas
+    // Tercer argumento: cantidad de consultas de cada tipo
+    // Cuarto argumento: binary (el campo aleatorio) o radial (un solo círculo)
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        tileSize = std::max(1, std::stoi(argv[2]));
+
+    if (argc > 3)
+        numQueries = std::max(1, std::stoi(argv[3]));
+
+    if (argc > 4)
+        fieldName = argv[4];
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", buckets de "
+              << tileSize << "x" << tileSize << ", campo " << fieldName << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    float isolevel = 0.5f;
+    std::mt19937 rng(42);
+
+    if (fieldName == "radial")
+    {
+        const float centerX = gridWidth / 2.0f, centerY = gridHeight / 2.0f;
+        for (int y = 0; y < gridHeight; ++y)
+        {
+            for (int x = 0; x < gridWidth; ++x)
+            {
+                float dx = x - centerX;
+                float dy = y - centerY;
+                scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+            }
+        }
+        isolevel = gridWidth / 4.0f;
+    }
+    else
+    {
+        for (float &v : scalarField)
+            v = (float)(rng() % 2);
+    }
+
+    double startTime = omp_get_wtime();
+    std::vector<LineSegment> allSegments = contourRows(scalarField, gridWidth, gridHeight, isolevel);
+    double endTime = omp_get_wtime();
+
+    std::cout << "Marching squares por filas tomó " << (endTime - startTime) * 1000.0 << " ms ("
+              << allSegments.size() << " segmentos)." << std::endl;
+
+    startTime = omp_get_wtime();
+    SegmentIndex index = contourIndexed(scalarField, gridWidth, gridHeight, isolevel, tileSize);
+    endTime = omp_get_wtime();
+
+    std::cout << "Marching squares con índice tomó " << (endTime - startTime) * 1000.0 << " ms ("
+              << index.segments.size() << " segmentos, " << index.tilesX * index.tilesY << " buckets)." << std::endl;
+
+    // Consultas al azar: cajas de hasta 1/10 de la malla y puntos en cualquier lugar
+    std::uniform_real_distribution<float> coordinate(0.0f, (float)(gridResolution - 1));
+    std::uniform_real_distribution<float> extent(1.0f, gridResolution / 10.0f);
+
+    std::vector<Box> boxes(numQueries);
+    std::vector<Point> points(numQueries);
+    for (int q = 0; q < numQueries; ++q)
+    {
+        float x = coordinate(rng), y = coordinate(rng);
+        boxes[q] = {x, y, x + extent(rng), y + extent(rng)};
+        points[q] = {coordinate(rng), coordinate(rng)};
+    }
+
+    std::vector<std::size_t> indexCounts(numQueries), linearCounts(numQueries);
+    std::vector<float> indexDistances(numQueries), linearDistances(numQueries);
+    std::vector<std::size_t> hits;
+
+    startTime = omp_get_wtime();
+    for (int q = 0; q < numQueries; ++q)
+    {
+        queryRange(index, boxes[q], hits);
+        indexCounts[q] = hits.size();
+    }
+    double indexRangeMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    startTime = omp_get_wtime();
+    for (int q = 0; q < numQueries; ++q)
+        linearCounts[q] = linearRangeCount(allSegments, boxes[q]);
+    double linearRangeMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    startTime = omp_get_wtime();
+    for (int q = 0; q < numQueries; ++q)
+        queryNearest(index, points[q], indexDistances[q]);
+    double indexNearestMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    startTime = omp_get_wtime();
+    for (int q = 0; q < numQueries; ++q)
+        linearDistances[q] = linearNearest(allSegments, points[q]);
+    double linearNearestMs = (omp_get_wtime() - startTime) * 1000.0;
+
+    int mismatches = 0;
+    for (int q = 0; q < numQueries; ++q)
+    {
+        if (indexCounts[q] != linearCounts[q] || std::fabs(indexDistances[q] - linearDistances[q]) > 1e-4f)
+            ++mismatches;
+    }
+
+    std::cout << "Rango: índice " << indexRangeMs / numQueries << " ms por consulta, lineal "
+              << linearRangeMs / numQueries << " ms por consulta." << std::endl;
+    std::cout << "Más cercano: índice " << indexNearestMs / numQueries << " ms por consulta, lineal "
+              << linearNearestMs / numQueries << " ms por consulta." << std::endl;
+
+    if (mismatches > 0)
+        std::cout << mismatches << " consultas no coinciden con la búsqueda lineal." << std::endl;
+    else
+        std::cout << "Las " << 2 * numQueries << " consultas coinciden con la búsqueda lineal." << std::endl;
+
+    return 0;
+}
@@ -0,0 +1,765 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <cerrno>
+#include <random>
+#include <iostream>
+#include <thread>
+#include <atomic>
+#include <unistd.h>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+// Sink es un std::vector<LineSegment> o el BlockSink del modo streaming, los dos tienen push_back
+template <typename Sink>
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 Sink& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// Una fila de celdas con el sliding window del checkpoint 5
+// Con un template se puede mandar la salida a un vector o a los bloques del writer
+template <typename Sink>
+void marchRowInto(const float *scalarField, int gridWidth, int y, float isolevel, Sink &sink)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, sink);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Bloques y colas
+// Cada hilo de marching tiene un pool fijo de POOL_BLOCKS bloques de BLOCK_SEGMENTS segmentos y dos colas
+// SPSC sin locks con el writer: una para mandarle bloques llenos y otra por la que el writer le devuelve
+// los bloques ya escritos. La memoria total queda fija en hilos x POOL_BLOCKS bloques, sin importar
+// cuántos segmentos salgan; si el disco va más lento, el hilo espera un bloque libre (backpressure)
+// ---------------------------------------------------------------------------
+const std::size_t BLOCK_SEGMENTS = 4096;
+const std::size_t POOL_BLOCKS = 16;
+const int ROWS_PER_CHUNK = 16;
+
+struct SegmentBlock
+{
+    int owner;         // hilo al que vuelve el bloque
+    int64_t chunk;     // bloque de filas del que salió
+    uint32_t count;
+    bool last;         // último bloque del chunk
+    LineSegment segments[BLOCK_SEGMENTS];
+};
+
+// Cola de un productor y un consumidor: head lo mueve solo el consumidor, tail solo el productor
+template <typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(std::size_t capacity)
+    {
+        std::size_t size = 1;
+        while (size < capacity)
+            size <<= 1;
+        slots_.resize(size);
+        mask_ = size - 1;
+    }
+
+    bool push(T value)
+    {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - head_.load(std::memory_order_acquire) > mask_)
+            return false;
+
+        slots_[tail & mask_] = value;
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T &value)
+    {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire))
+            return false;
+
+        value = slots_[head & mask_];
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    std::vector<T> slots_;
+    std::size_t mask_;
+    alignas(64) std::atomic<std::size_t> head_{0};
+    alignas(64) std::atomic<std::size_t> tail_{0};
+};
+
+struct alignas(64) ThreadChannel
+{
+    std::vector<std::unique_ptr<SegmentBlock>> pool;
+    SpscQueue<SegmentBlock *> full{POOL_BLOCKS};
+    SpscQueue<SegmentBlock *> free{POOL_BLOCKS};
+};
+
+// Destino de marchSquare en el modo streaming: llena el bloque actual y lo manda al writer cuando se llena
+class BlockSink
+{
+public:
+    BlockSink(ThreadChannel &channel) : channel_(channel) {}
+
+    void startChunk(int64_t chunk)
+    {
+        chunk_ = chunk;
+        current_ = acquire();
+    }
+
+    // El último bloque del chunk se manda aunque esté vacío: le avisa al writer que el chunk terminó
+    void finishChunk()
+    {
+        current_->last = true;
+        send();
+    }
+
+    void push_back(const LineSegment &segment)
+    {
+        current_->segments[current_->count++] = segment;
+
+        if (current_->count == BLOCK_SEGMENTS)
+        {
+            send();
+            current_ = acquire();
+        }
+    }
+
+private:
+    ThreadChannel &channel_;
+    SegmentBlock *current_ = nullptr;
+    int64_t chunk_ = 0;
+
+    SegmentBlock *acquire()
+    {
+        SegmentBlock *block;
+        while (!channel_.free.pop(block))
+            std::this_thread::yield();
+
+        block->chunk = chunk_;
+        block->count = 0;
+        block->last = false;
+        return block;
+    }
+
+    void send()
+    {
+        // La cola tiene lugar para todo el pool, nunca está llena
+        channel_.full.push(current_);
+        current_ = nullptr;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// Writer
+// Modos:
+//  - unordered: escribe los bloques apenas llegan
+//  - ordered: escribe los chunks en orden de filas (el mismo archivo que una barrida secuencial); los bloques
+//    que llegan adelantados se guardan en memoria, y como son del pool del hilo eso ya está acotado
+//  - spill: como ordered, pero los bloques adelantados se copian a un archivo temporal y el bloque vuelve
+//    de inmediato al hilo, así ningún hilo espera por el orden y la memoria es solo la de los pools
+// Ningún deadlock en ordered: los chunks se reparten en orden creciente, el hilo que tiene el siguiente
+// chunk a escribir no tiene bloques retenidos de chunks posteriores
+// Si falla una escritura o una lectura del archivo temporal el writer no inventa datos: anota el error, deja de
+// escribir y solo devuelve bloques a los pools hasta que los hilos de marching, que miran failed(), terminen
+// ---------------------------------------------------------------------------
+enum class WriteMode
+{
+    Unordered,
+    Ordered,
+    Spill
+};
+
+struct PendingPiece
+{
+    SegmentBlock *block;    // en memoria (ordered)
+    uint64_t spillOffset;   // o en el archivo temporal (spill)
+    uint32_t count;
+    bool last;
+};
+
+struct StreamStats
+{
+    std::size_t segments = 0;
+    std::size_t blocks = 0;
+    std::size_t spilledBlocks = 0;
+    std::size_t maxPendingBlocks = 0;
+    std::string error;   // vacío si todo se escribió
+};
+
+class SegmentWriter
+{
+public:
+    SegmentWriter(std::FILE *output, WriteMode mode, std::vector<ThreadChannel> &channels, int64_t numChunks)
+        : output_(output), mode_(mode), channels_(channels), numChunks_(numChunks)
+    {
+        if (mode_ == WriteMode::Spill)
+            spill_ = std::tmpfile();
+    }
+
+    ~SegmentWriter()
+    {
+        if (spill_ != nullptr)
+            std::fclose(spill_);
+    }
+
+    bool ok() const { return mode_ != WriteMode::Spill || spill_ != nullptr; }
+
+    bool failed() const { return failed_.load(std::memory_order_acquire); }
+
+    // Corre en su propio hilo hasta que se escribieron todos los chunks o hasta que algo falló y los
+    // productores ya terminaron
+    StreamStats run(const std::atomic<bool> &producersDone)
+    {
+        std::vector<LineSegment> readBack;
+
+        while (completedChunks_ < numChunks_ && !failed())
+        {
+            bool progress = false;
+
+            for (ThreadChannel &channel : channels_)
+            {
+                SegmentBlock *block;
+                while (channel.full.pop(block))
+                {
+                    progress = true;
+                    receive(block, readBack);
+                }
+            }
+
+            if (!progress)
+                std::this_thread::yield();
+        }
+
+        if (failed())
+            drain(producersDone);
+        else if (std::fflush(output_) != 0)
+            fail("no se pudo escribir la salida");
+
+        return stats_;
+    }
+
+private:
+    std::FILE *output_;
+    std::FILE *spill_ = nullptr;
+    uint64_t spillSize_ = 0;
+    WriteMode mode_;
+    std::vector<ThreadChannel> &channels_;
+    int64_t numChunks_;
+    int64_t completedChunks_ = 0;
+    std::map<int64_t, std::vector<PendingPiece>> pending_;
+    std::size_t pendingBlocks_ = 0;
+    StreamStats stats_;
+    std::atomic<bool> failed_{false};
+
+    void fail(const char *what)
+    {
+        if (failed())
+            return;
+
+        stats_.error = std::string(what) + ": " + std::strerror(errno);
+        failed_.store(true, std::memory_order_release);
+
+        // Lo retenido ya no se va a escribir; los bloques vuelven a sus hilos para que ninguno quede esperando
+        for (auto &entry : pending_)
+            for (const PendingPiece &piece : entry.second)
+                if (piece.block != nullptr)
+                    release(piece.block);
+        pending_.clear();
+        pendingBlocks_ = 0;
+    }
+
+    // Después de un error: devuelve todo lo que llegue hasta que los productores terminen
+    void drain(const std::atomic<bool> &producersDone)
+    {
+        for (;;)
+        {
+            const bool done = producersDone.load(std::memory_order_acquire);
+
+            for (ThreadChannel &channel : channels_)
+            {
+                SegmentBlock *block;
+                while (channel.full.pop(block))
+                    release(block);
+            }
+
+            if (done)
+                return;
+            std::this_thread::yield();
+        }
+    }
+
+    void write(const LineSegment *segments, uint32_t count)
+    {
+        if (std::fwrite(segments, sizeof(LineSegment), count, output_) != count)
+        {
+            fail("no se pudo escribir la salida");
+            return;
+        }
+        stats_.segments += count;
+        stats_.blocks += 1;
+    }
+
+    // pread hasta tener los count segmentos; una lectura corta es un error, no ceros
+    bool readSpill(uint64_t offset, uint32_t count, std::vector<LineSegment> &readBack)
+    {
+        readBack.resize(count);
+        char *destination = reinterpret_cast<char *>(readBack.data());
+        std::size_t remaining = std::size_t(count) * sizeof(LineSegment);
+
+        while (remaining > 0)
+        {
+            const ssize_t got = pread(fileno(spill_), destination, remaining, (off_t)offset);
+            if (got < 0 && errno == EINTR)
+                continue;
+            if (got <= 0)
+            {
+                if (got == 0)
+                    errno = EIO;
+                return false;
+            }
+
+            destination += got;
+            offset += got;
+            remaining -= got;
+        }
+        return true;
+    }
+
+    void release(SegmentBlock *block)
+    {
+        channels_[block->owner].free.push(block);
+    }
+
+    void receive(SegmentBlock *block, std::vector<LineSegment> &readBack)
+    {
+        if (failed())
+        {
+            release(block);
+            return;
+        }
+
+        if (mode_ == WriteMode::Unordered || block->chunk == completedChunks_)
+        {
+            const bool last = block->last;
+            write(block->segments, block->count);
+            release(block);
+
+            if (last)
+            {
+                ++completedChunks_;
+                if (mode_ != WriteMode::Unordered)
+                    flushPending(readBack);
+            }
+            return;
+        }
+
+        // Llegó adelantado: se guarda hasta que le toque
+        // chunk y count se copian antes de release(): el productor vuelve a llenar el bloque apenas lo recibe
+        const int64_t chunk = block->chunk;
+        PendingPiece piece = {nullptr, 0, block->count, block->last};
+
+        if (mode_ == WriteMode::Spill)
+        {
+            piece.spillOffset = spillSize_;
+            const bool written = std::fwrite(block->segments, sizeof(LineSegment), piece.count, spill_) == piece.count;
+            release(block);
+
+            if (!written)
+            {
+                fail("no se pudo escribir el archivo temporal");
+                return;
+            }
+            spillSize_ += uint64_t(piece.count) * sizeof(LineSegment);
+            stats_.spilledBlocks += 1;
+        }
+        else
+        {
+            piece.block = block;
+            ++pendingBlocks_;
+            stats_.maxPendingBlocks = std::max(stats_.maxPendingBlocks, pendingBlocks_);
+        }
+
+        pending_[chunk].push_back(piece);
+    }
+
+    // Escribe lo guardado del chunk que sigue mientras haya; si ese chunk todavía no terminó, lo que falte
+    // llega después directo
+    void flushPending(std::vector<LineSegment> &readBack)
+    {
+        for (auto it = pending_.find(completedChunks_); it != pending_.end(); it = pending_.find(completedChunks_))
+        {
+            bool finished = false;
+            std::vector<PendingPiece> pieces = std::move(it->second);
+            pending_.erase(it);
+
+            for (std::size_t p = 0; p < pieces.size(); ++p)
+            {
+                const PendingPiece &piece = pieces[p];
+
+                if (failed())
+                {
+                    // fail() ya soltó lo que estaba en pending_; los bloques de este chunk se sueltan acá
+                    if (piece.block != nullptr)
+                        release(piece.block);
+                    continue;
+                }
+
+                if (piece.block != nullptr)
+                {
+                    write(piece.block->segments, piece.count);
+                    release(piece.block);
+                    --pendingBlocks_;
+                }
+                else if (std::fflush(spill_) != 0 || !readSpill(piece.spillOffset, piece.count, readBack))
+                    fail("no se pudo leer el archivo temporal");
+                else
+                    write(readBack.data(), piece.count);
+
+                finished = finished || piece.last;
+            }
+
+            if (failed())
+                return;
+
+            if (!finished)
+                break;
+
+            ++completedChunks_;
+        }
+    }
+};
+
+// Marching en paralelo con el writer en un hilo aparte
+// Los chunks de ROWS_PER_CHUNK filas se reparten con un contador atómico, en orden creciente
+// Devuelve false si la salida quedó incompleta; el motivo queda en stats.error
+bool contourStreaming(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel,
+                      WriteMode mode, std::FILE *output, StreamStats &stats)
+{
+    const int numThreads = omp_get_max_threads();
+    const int64_t numChunks = (gridHeight - 1 + ROWS_PER_CHUNK - 1) / ROWS_PER_CHUNK;
+
+    std::vector<ThreadChannel> channels(numThreads);
+    for (int t = 0; t < numThreads; ++t)
+    {
+        for (std::size_t b = 0; b < POOL_BLOCKS; ++b)
+        {
+            channels[t].pool.emplace_back(new SegmentBlock);
+            channels[t].pool.back()->owner = t;
+            channels[t].free.push(channels[t].pool.back().get());
+        }
+    }
+
+    SegmentWriter writer(output, mode, channels, numChunks);
+    if (!writer.ok())
+    {
+        stats = StreamStats();
+        stats.error = std::string("no se pudo crear el archivo temporal: ") + std::strerror(errno);
+        return false;
+    }
+
+    std::atomic<bool> producersDone(false);
+    std::thread writerThread([&] { stats = writer.run(producersDone); });
+
+    std::atomic<int64_t> nextChunk(0);
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        BlockSink sink(channels[omp_get_thread_num()]);
+
+        for (int64_t chunk = nextChunk++; chunk < numChunks && !writer.failed(); chunk = nextChunk++)
+        {
+            sink.startChunk(chunk);
+
+            const int y0 = int(chunk * ROWS_PER_CHUNK);
+            const int y1 = std::min(gridHeight - 1, y0 + ROWS_PER_CHUNK);
+            for (int y = y0; y < y1; ++y)
+                marchRowInto(scalarField.data(), gridWidth, y, isolevel, sink);
+
+            sink.finishChunk();
+        }
+    }
+
+    producersDone.store(true, std::memory_order_release);
+    writerThread.join();
+    return stats.error.empty();
+}
+
+// Lo que se hace hoy: todo en memoria hasta el final de la región paralela y después se escribe
+std::size_t contourThenWrite(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel, std::FILE *output)
+{
+    std::vector<LineSegment> allSegments;
+
+    #pragma omp parallel
+    {
+        std::vector<LineSegment> privateSegments;
+
+        #pragma omp for nowait
+        for (int y = 0; y < gridHeight - 1; ++y)
+            marchRowInto(scalarField.data(), gridWidth, y, isolevel, privateSegments);
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    std::fwrite(allSegments.data(), sizeof(LineSegment), allSegments.size(), output);
+    std::fflush(output);
+    return allSegments.size();
+}
+
+// Compara el archivo contra una barrida secuencial, fila por fila, sin cargar todo a memoria
+bool matchesSequential(const std::string &filename, const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel)
+{
+    std::FILE *file = std::fopen(filename.c_str(), "rb");
+    if (file == nullptr)
+        return false;
+
+    std::vector<LineSegment> expected, actual;
+    bool same = true;
+
+    for (int y = 0; y < gridHeight - 1 && same; ++y)
+    {
+        expected.clear();
+        marchRowInto(scalarField.data(), gridWidth, y, isolevel, expected);
+
+        actual.resize(expected.size());
+        same = std::fread(actual.data(), sizeof(LineSegment), actual.size(), file) == actual.size() &&
+               std::memcmp(actual.data(), expected.data(), expected.size() * sizeof(LineSegment)) == 0;
+    }
+
+    same = same && std::fgetc(file) == EOF;
+    std::fclose(file);
+    return same;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 4000;
+    std::string modeName = "ordered";
+    std::string outputFilename = "segments.bin";
+    int runs = 1;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: unordered, ordered o spill
+    // Tercer argumento: archivo de salida (segmentos como 4 floats: x0 y0 x1 y1)
+    // Cuarto argumento: cuántas veces se repite el streaming, verificando el archivo en cada corrida
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        modeName = argv[2];
+
+    if (argc > 3 && argv[3][0] != '\0')
+        outputFilename = argv[3];
+
+    if (argc > 4 && argv[4][0] != '\0')
+        runs = std::max(1, std::stoi(argv[4]));
+
+    const WriteMode mode = modeName == "unordered" ? WriteMode::Unordered
+                         : modeName == "spill"     ? WriteMode::Spill
+                                                   : WriteMode::Ordered;
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", modo " << modeName << std::endl;
+
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    std::mt19937 rng(42);
+    for (float &v : scalarField)
+        v = (float)(rng() % 2);
+
+    // Buffer de escritura grande: el writer manda bloques de 64 KB
+    std::vector<char> fileBuffer(std::size_t(1) << 22);
+
+    std::FILE *output = std::fopen(outputFilename.c_str(), "wb");
+    if (output == nullptr)
+    {
+        std::cerr << "No se pudo abrir " << outputFilename << std::endl;
+        return 1;
+    }
+    std::setvbuf(output, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+    double startTime = omp_get_wtime();
+    std::size_t segments = contourThenWrite(scalarField, gridWidth, gridHeight, isolevel, output);
+    double endTime = omp_get_wtime();
+    std::fclose(output);
+
+    std::cout << "En memoria y después a disco: " << (endTime - startTime) * 1000.0 << " ms, " << segments << " segmentos, "
+              << segments * sizeof(LineSegment) / (1024.0 * 1024.0) << " MB retenidos." << std::endl;
+
+    // El orden en que llegan los bloques cambia de una corrida a otra, así que en ordered/spill cada corrida
+    // se verifica por separado: un error de carrera en el writer puede aparecer en una sola de ellas
+    const double poolMegabytes = omp_get_max_threads() * POOL_BLOCKS * sizeof(SegmentBlock) / (1024.0 * 1024.0);
+    int mismatches = 0;
+
+    for (int run = 0; run < runs; ++run)
+    {
+        output = std::fopen(outputFilename.c_str(), "wb");
+        if (output == nullptr)
+        {
+            std::cerr << "No se pudo abrir " << outputFilename << std::endl;
+            return 1;
+        }
+        std::setvbuf(output, fileBuffer.data(), _IOFBF, fileBuffer.size());
+
+        startTime = omp_get_wtime();
+        StreamStats stats;
+        bool written = contourStreaming(scalarField, gridWidth, gridHeight, isolevel, mode, output, stats);
+        endTime = omp_get_wtime();
+
+        if (std::fclose(output) != 0 && written)
+        {
+            written = false;
+            stats.error = std::string("no se pudo cerrar la salida: ") + std::strerror(errno);
+        }
+
+        if (!written)
+        {
+            std::cerr << "Streaming falló, " << outputFilename << " quedó incompleto: " << stats.error << std::endl;
+            return 1;
+        }
+
+        std::cout << "Streaming: " << (endTime - startTime) * 1000.0 << " ms, " << stats.segments << " segmentos en "
+                  << stats.blocks << " bloques, " << poolMegabytes << " MB de pools." << std::endl;
+
+        if (mode == WriteMode::Ordered)
+            std::cout << "Bloques adelantados retenidos a la vez: " << stats.maxPendingBlocks << "." << std::endl;
+        if (mode == WriteMode::Spill)
+            std::cout << "Bloques adelantados al archivo temporal: " << stats.spilledBlocks << "." << std::endl;
+
+        if (mode != WriteMode::Unordered)
+        {
+            const bool same = matchesSequential(outputFilename, scalarField, gridWidth, gridHeight, isolevel);
+            std::cout << (same ? "El archivo coincide con una barrida secuencial."
+                               : "El archivo NO coincide con una barrida secuencial.")
+                      << std::endl;
+            mismatches += !same;
+        }
+    }
+
+    if (mismatches > 0)
+    {
+        std::cout << mismatches << " de " << runs << " corridas no coinciden con la barrida secuencial." << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,567 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <chrono>
+#include <fstream>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <omp.h>
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+// Formato en disco:
+//  - Cabecera: magic "MSQTILE1" + ancho, alto, tamaño de tile, tiles en x, tiles en y
+//  - Índice: un TileEntry por tile (offset, tamaño y min/max de sus muestras)
+//  - Datos: cada tile linealizado (row-major) en float
+//
+// Cada tile de tileSize x tileSize celdas guarda también la primera fila y columna del siguiente,
+// así se puede hacer marching sobre un tile sin leer a sus vecinos
+const char TILED_MAGIC[8] = {'M', 'S', 'Q', 'T', 'I', 'L', 'E', '1'};
+
+struct TiledHeader
+{
+    char magic[8];
+    uint32_t width, height;
+    uint32_t tileSize;
+    uint32_t tilesX, tilesY;
+};
+
+struct TileEntry
+{
+    uint64_t offset;
+    uint32_t width, height;
+    float minValue, maxValue;
+};
+
+struct TiledField
+{
+    int fd = -1;
+    TiledHeader header;
+    std::vector<TileEntry> index;
+};
+
+bool preadAll(int fd, void *buffer, std::size_t bytes, uint64_t offset)
+{
+    char *out = static_cast<char *>(buffer);
+
+    while (bytes > 0)
+    {
+        ssize_t got = pread(fd, out, bytes, (off_t)offset);
+        if (got <= 0)
+            return false;
+
+        out += got;
+        bytes -= got;
+        offset += got;
+    }
+
+    return true;
+}
+
+bool pwriteAll(int fd, const void *buffer, std::size_t bytes, uint64_t offset)
+{
+    const char *in = static_cast<const char *>(buffer);
+
+    while (bytes > 0)
+    {
+        ssize_t put = pwrite(fd, in, bytes, (off_t)offset);
+        if (put <= 0)
+            return false;
+
+        in += put;
+        bytes -= put;
+        offset += put;
+    }
+
+    return true;
+}
+
+// Escribe el scalarField linealizado en formato de tiles
+// Cada hilo copia sus tiles a un buffer propio, calcula su min/max y los escribe con pwrite
+bool writeTiledField(const std::string &path, const std::vector<float> &scalarField,
+                     int gridWidth, int gridHeight, int tileSize)
+{
+    TiledHeader header;
+    std::memcpy(header.magic, TILED_MAGIC, sizeof(header.magic));
+    header.width = gridWidth;
+    header.height = gridHeight;
+    header.tileSize = tileSize;
+    header.tilesX = (gridWidth - 1 + tileSize - 1) / tileSize;
+    header.tilesY = (gridHeight - 1 + tileSize - 1) / tileSize;
+
+    const int tileCount = header.tilesX * header.tilesY;
+    std::vector<TileEntry> index(tileCount);
+
+    uint64_t offset = sizeof(TiledHeader) + sizeof(TileEntry) * (uint64_t)tileCount;
+    for (int t = 0; t < tileCount; ++t)
+    {
+        int tx = t % header.tilesX, ty = t / header.tilesX;
+        int x0 = tx * tileSize, y0 = ty * tileSize;
+
+        index[t].offset = offset;
+        index[t].width = std::min(x0 + tileSize, gridWidth - 1) - x0 + 1;
+        index[t].height = std::min(y0 + tileSize, gridHeight - 1) - y0 + 1;
+        offset += sizeof(float) * (uint64_t)index[t].width * index[t].height;
+    }
+
+    int fd = open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY, 0644);
+    if (fd < 0)
+        return false;
+
+    bool ok = true;
+
+    #pragma omp parallel
+    {
+        std::vector<float> tile;
+
+        #pragma omp for schedule(dynamic)
+        for (int t = 0; t < tileCount; ++t)
+        {
+            TileEntry &entry = index[t];
+            int x0 = (t % header.tilesX) * tileSize, y0 = (t / header.tilesX) * tileSize;
+
+            tile.resize(std::size_t(entry.width) * entry.height);
+            float minValue = scalarField[std::size_t(y0) * gridWidth + x0];
+            float maxValue = minValue;
+
+            for (uint32_t y = 0; y < entry.height; ++y)
+            {
+                const float *row = &scalarField[std::size_t(y0 + y) * gridWidth + x0];
+                for (uint32_t x = 0; x < entry.width; ++x)
+                {
+                    tile[std::size_t(y) * entry.width + x] = row[x];
+                    minValue = std::min(minValue, row[x]);
+                    maxValue = std::max(maxValue, row[x]);
+                }
+            }
+
+            entry.minValue = minValue;
+            entry.maxValue = maxValue;
+
+            if (!pwriteAll(fd, tile.data(), tile.size() * sizeof(float), entry.offset))
+            {
+                #pragma omp atomic write
+                ok = false;
+            }
+        }
+    }
+
+    ok = ok && pwriteAll(fd, &header, sizeof(header), 0);
+    ok = ok && pwriteAll(fd, index.data(), index.size() * sizeof(TileEntry), sizeof(header));
+
+    close(fd);
+    return ok;
+}
+
+// La cabecera y el índice tienen que describir tiles que entren en el archivo:
+// tileSize > 0, la cantidad de tiles que sale de ancho/alto y cada tile con el tamaño que le toca
+bool validTiledIndex(const TiledHeader &header, const std::vector<TileEntry> &index, uint64_t fileBytes)
+{
+    const uint64_t dataStart = sizeof(TiledHeader) + sizeof(TileEntry) * (uint64_t)index.size();
+
+    for (std::size_t t = 0; t < index.size(); ++t)
+    {
+        const uint64_t x0 = (t % header.tilesX) * (uint64_t)header.tileSize;
+        const uint64_t y0 = (t / header.tilesX) * (uint64_t)header.tileSize;
+        const uint64_t width = std::min<uint64_t>(x0 + header.tileSize, header.width - 1) - x0 + 1;
+        const uint64_t height = std::min<uint64_t>(y0 + header.tileSize, header.height - 1) - y0 + 1;
+
+        const TileEntry &entry = index[t];
+        if (entry.width != width || entry.height != height)
+            return false;
+
+        if (entry.offset < dataStart || entry.offset > fileBytes ||
+            fileBytes - entry.offset < sizeof(float) * width * height)
+            return false;
+    }
+
+    return true;
+}
+
+// Solo lee la cabecera y el índice; los datos se leen por tile bajo demanda
+// Se rechaza el archivo si la cabecera o el índice no coinciden con su tamaño
+bool openTiledField(const std::string &path, TiledField &field)
+{
+    field.fd = open(path.c_str(), O_RDONLY);
+    if (field.fd < 0)
+        return false;
+
+    auto fail = [&field]()
+    {
+        close(field.fd);
+        field.fd = -1;
+        field.index.clear();
+        return false;
+    };
+
+    struct stat info;
+    if (fstat(field.fd, &info) != 0)
+        return fail();
+
+    const uint64_t fileBytes = info.st_size;
+    const TiledHeader &header = field.header;
+
+    if (fileBytes < sizeof(TiledHeader) || !preadAll(field.fd, &field.header, sizeof(TiledHeader), 0) ||
+        std::memcmp(header.magic, TILED_MAGIC, sizeof(TILED_MAGIC)) != 0)
+        return fail();
+
+    // Con tileSize 0 la cantidad de tiles divide por cero; la malla necesita al menos una celda
+    if (header.tileSize == 0 || header.width < 2 || header.height < 2 ||
+        header.width > INT32_MAX || header.height > INT32_MAX ||
+        header.tilesX != (header.width - 2) / header.tileSize + 1 ||
+        header.tilesY != (header.height - 2) / header.tileSize + 1)
+        return fail();
+
+    // El índice tiene que entrar en el archivo antes de reservarlo
+    const uint64_t tileCount = uint64_t(header.tilesX) * header.tilesY;
+    if ((fileBytes - sizeof(TiledHeader)) / sizeof(TileEntry) < tileCount)
+        return fail();
+
+    field.index.resize(tileCount);
+    if (!preadAll(field.fd, field.index.data(), field.index.size() * sizeof(TileEntry), sizeof(TiledHeader)) ||
+        !validTiledIndex(header, field.index, fileBytes))
+        return fail();
+
+    return true;
+}
+
+void closeTiledField(TiledField &field)
+{
+    if (field.fd >= 0)
+        close(field.fd);
+
+    field.fd = -1;
+}
+
+// Marching squares sobre las celdas [x0, x1) x [y0, y1) leyendo del archivo
+// Solo se leen los tiles que se solapan con la ventana y cuyo min/max cruza el isolevel
+// Devuelve false si falló la lectura de algún tile; bytesRead y tilesRead cuentan solo lo que sí se leyó
+bool contourRegion(const TiledField &field, float isolevel,
+                   int x0, int y0, int x1, int y1,
+                   std::vector<LineSegment> &allSegments,
+                   std::size_t &bytesRead, int &tilesRead)
+{
+    const TiledHeader &header = field.header;
+    const int tileSize = header.tileSize;
+
+    x0 = std::max(x0, 0);
+    y0 = std::max(y0, 0);
+    x1 = std::min(x1, (int)header.width - 1);
+    y1 = std::min(y1, (int)header.height - 1);
+
+    allSegments.clear();
+    bytesRead = 0;
+    tilesRead = 0;
+
+    if (x0 >= x1 || y0 >= y1)
+        return true;
+
+    // Tiles candidatos: se descartan los que quedan enteros por encima o por debajo del isolevel
+    std::vector<int> tiles;
+    for (int ty = y0 / tileSize; ty <= (y1 - 1) / tileSize; ++ty)
+    {
+        for (int tx = x0 / tileSize; tx <= (x1 - 1) / tileSize; ++tx)
+        {
+            const TileEntry &entry = field.index[std::size_t(ty) * header.tilesX + tx];
+            if (entry.maxValue < isolevel || entry.minValue >= isolevel)
+                continue;
+
+            tiles.push_back(ty * header.tilesX + tx);
+        }
+    }
+
+    std::size_t totalBytes = 0;
+    int totalTiles = 0;
+    bool ok = true;
+
+    #pragma omp parallel reduction(+ : totalBytes, totalTiles)
+    {
+        std::vector<LineSegment> privateSegments;
+        std::vector<float> tile;
+
+        #pragma omp for nowait schedule(dynamic)
+        for (std::size_t i = 0; i < tiles.size(); ++i)
+        {
+            const TileEntry &entry = field.index[tiles[i]];
+            const int tileX = (tiles[i] % header.tilesX) * tileSize;
+            const int tileY = (tiles[i] / header.tilesX) * tileSize;
+
+            // Solo las filas del tile que caen en la ventana (más la fila de abajo de la última celda)
+            const int cellY0 = std::max(y0, tileY) - tileY;
+            const int cellY1 = std::min(y1, tileY + (int)entry.height - 1) - tileY;
+            const int cellX0 = std::max(x0, tileX) - tileX;
+            const int cellX1 = std::min(x1, tileX + (int)entry.width - 1) - tileX;
+            const int width = entry.width;
+
+            const std::size_t rows = cellY1 - cellY0 + 1;
+            tile.resize(rows * width);
+
+            uint64_t offset = entry.offset + sizeof(float) * (uint64_t)cellY0 * width;
+            if (!preadAll(field.fd, tile.data(), tile.size() * sizeof(float), offset))
+            {
+                #pragma omp atomic write
+                ok = false;
+                continue;
+            }
+            totalBytes += tile.size() * sizeof(float);
+            ++totalTiles;
+
+            for (int y = cellY0; y < cellY1; ++y)
+            {
+                const float *top = &tile[std::size_t(y - cellY0) * width];
+                const float *bottom = top + width;
+
+                float left_top_val = top[cellX0];
+                float left_bottom_val = bottom[cellX0];
+
+                for (int x = cellX0; x < cellX1; ++x)
+                {
+                    float right_top_val = top[x + 1];
+                    float right_bottom_val = bottom[x + 1];
+
+                    float values[4] = {
+                        left_top_val,
+                        right_top_val,
+                        right_bottom_val,
+                        left_bottom_val
+                    };
+
+                    marchSquare((float)(tileX + x), (float)(tileY + y), values, isolevel, privateSegments);
+
+                    left_top_val = right_top_val;
+                    left_bottom_val = right_bottom_val;
+                }
+            }
+        }
+
+        #pragma omp critical
+        allSegments.insert(allSegments.end(), privateSegments.begin(), privateSegments.end());
+    }
+
+    bytesRead = totalBytes;
+    tilesRead = totalTiles;
+    return ok;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 4000;
+    int tileSize = 256;
+    const std::string filename = "field.msqt";
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: tamaño de los tiles
+    // Del tercero al sexto: ventana x0 y0 x1 y1 a contornear
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        tileSize = std::stoi(argv[2]);
+
+    if (tileSize <= 0)
+    {
+        std::cerr << "El tamaño de tile tiene que ser mayor que 0" << std::endl;
+        return 1;
+    }
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    // Por defecto una ventana de 1024x1024 que corta el círculo del isolevel
+    const float isolevel = gridWidth / 4.0f;
+
+    // La ventana va completa o no va: con solo una parte se avisa en vez de ignorarla
+    if (argc > 3 && argc < 7)
+    {
+        std::cerr << "La ventana necesita los cuatro valores: x0 y0 x1 y1" << std::endl;
+        return 1;
+    }
+
+    int window[4] = {gridWidth / 4 - 512, gridHeight / 2 - 512, gridWidth / 4 + 512, gridHeight / 2 + 512};
+    if (argc > 6)
+        for (int i = 0; i < 4; ++i)
+            window[i] = std::stoi(argv[3 + i]);
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << std::endl;
+
+    // Función de distancia radial como en el checkpoint 1
+    // La mayoría de tiles no cruzan el isolevel, así que el índice de min/max permite saltarlos
+    std::vector<float> scalarField(std::size_t(gridWidth) * gridHeight);
+    Point center = {(float)gridWidth / 2.0f, (float)gridHeight / 2.0f};
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float dx = x - center.x;
+            float dy = y - center.y;
+            scalarField[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    double startTime = omp_get_wtime();
+    if (!writeTiledField(filename, scalarField, gridWidth, gridHeight, tileSize))
+    {
+        std::cerr << "No se pudo escribir " << filename << std::endl;
+        return 1;
+    }
+    double endTime = omp_get_wtime();
+
+    std::cout << "Se escribió " << filename << " en " << (endTime - startTime) * 1000.0 << " ms." << std::endl;
+
+    // A partir de aquí ya no usamos el campo en memoria
+    scalarField.clear();
+    scalarField.shrink_to_fit();
+
+    TiledField field;
+    if (!openTiledField(filename, field))
+    {
+        std::cerr << "No se pudo abrir " << filename << std::endl;
+        return 1;
+    }
+
+    std::vector<LineSegment> regionSegments;
+    std::size_t bytesRead = 0;
+    int tilesRead = 0;
+
+    startTime = omp_get_wtime();
+    bool ok = contourRegion(field, isolevel, window[0], window[1], window[2], window[3],
+                            regionSegments, bytesRead, tilesRead);
+    endTime = omp_get_wtime();
+
+    if (!ok)
+    {
+        std::cerr << "Error leyendo tiles de " << filename << " (se leyeron " << tilesRead << ")." << std::endl;
+        closeTiledField(field);
+        return 1;
+    }
+
+    std::size_t fileBytes = field.index.back().offset +
+                            sizeof(float) * (std::size_t)field.index.back().width * field.index.back().height;
+
+    std::cout << "Ventana (" << window[0] << ", " << window[1] << ") - (" << window[2] << ", " << window[3]
+              << ") tomó " << (endTime - startTime) * 1000.0 << " ms y generó " << regionSegments.size() << " segmentos." << std::endl;
+    std::cout << "Se leyeron " << tilesRead << " tiles (" << bytesRead / (1024.0 * 1024.0) << " MB de "
+              << fileBytes / (1024.0 * 1024.0) << " MB del archivo)." << std::endl;
+
+    // Referencia: la malla completa leída desde el mismo archivo
+    std::vector<LineSegment> fullSegments;
+
+    startTime = omp_get_wtime();
+    ok = contourRegion(field, isolevel, 0, 0, gridWidth - 1, gridHeight - 1, fullSegments, bytesRead, tilesRead);
+    endTime = omp_get_wtime();
+
+    if (!ok)
+    {
+        std::cerr << "Error leyendo tiles de " << filename << " (se leyeron " << tilesRead << ")." << std::endl;
+        closeTiledField(field);
+        return 1;
+    }
+
+    std::cout << "Malla completa tomó " << (endTime - startTime) * 1000.0 << " ms y generó "
+              << fullSegments.size() << " segmentos." << std::endl;
+
+    closeTiledField(field);
+
+    return 0;
+}
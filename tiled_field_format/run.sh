@@ -0,0 +1,27 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="march"
+
+if [ -n "$3" ]; then
+  export OMP_NUM_THREADS=$3
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17
+echo "Compilación exitosa. Ejecutable creado: $EXECUTABLE_NAME"
+echo ""
+
+echo "Corriendo el ejecutable..."
+# Del cuarto argumento en adelante va la ventana x0 y0 x1 y1
+GRID_SIZE=$1
+TILE_SIZE=$2
+if [ $# -gt 3 ]; then
+  shift 3
+else
+  set --
+fi
+./"$EXECUTABLE_NAME" "$GRID_SIZE" "$TILE_SIZE" "$@"
+echo ""
+
+echo "Proceso completado."
@@ -0,0 +1,1156 @@
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <cstdint>
+#include <ctime>
+#include <vector>
+#include <cmath>
+#include <array>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <atomic>
+#include <random>
+#include <new>
+#include <omp.h>
+
+#include "../common/memory_counter.h"
+
+// ---------------------------------------------------------------------------
+// Conteo de trabajo y tráfico para el modo roofline
+// Solo cuentan mientras counting está activo (una corrida aparte, no las que se miden), así las corridas medidas
+// pagan una rama predecible y nada más
+//  - lerp: cada carpeta llama al hook MARCHING_COUNT_LERP en su lerp; acá suma en el contador de su hilo
+//  - buffers: el operator new global suma los bytes que se reservan durante la corrida
+// ---------------------------------------------------------------------------
+struct alignas(64) LerpCounter
+{
+    long long calls = 0;
+    long long degenerate = 0;   // llamadas que salen por |v2 - v1| < EPS
+};
+
+bool counting = false;
+std::vector<LerpCounter> lerpCounters;
+std::atomic<long long> allocatedBytes{0};
+
+inline void countLerp(bool degenerate)
+{
+    if (counting)
+    {
+        LerpCounter &counter = lerpCounters[omp_get_thread_num()];
+        ++counter.calls;
+        counter.degenerate += degenerate;
+    }
+}
+
+#define MARCHING_COUNT_LERP(degenerate) ::countLerp(degenerate)
+
+void *operator new(std::size_t size)
+{
+    if (counting)
+        allocatedBytes.fetch_add((long long)size, std::memory_order_relaxed);
+
+    if (void *p = std::malloc(size == 0 ? 1 : size))
+        return p;
+
+    throw std::bad_alloc();
+}
+
+// Al inlinear delete g++ ve un free sobre memoria de operator new; acá los dos usan malloc/free
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+
+void operator delete(void *p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void *p, std::size_t) noexcept
+{
+    std::free(p);
+}
+
+#pragma GCC diagnostic pop
+
+// ---------------------------------------------------------------------------
+// Kernels de las carpetas
+// Cada carpeta se compila acá dentro de su propio namespace con su main renombrado, así la suite mide y verifica
+// el mismo código que corre la carpeta y no una copia. Todos los headers que usan ya están incluidos arriba, así que
+// sus #include no meten nada dentro del namespace
+// ---------------------------------------------------------------------------
+#define main folder_main
+
+namespace checkpoint_1
+{
+#include "../checkpoint_1/marching_squares.cpp"
+}
+
+namespace checkpoint_2
+{
+#include "../checkpoint_2/marching_squares.cpp"
+}
+
+namespace checkpoint_3
+{
+#include "../checkpoint_3/marching_squares.cpp"
+}
+
+namespace checkpoint_4
+{
+#include "../checkpoint_4/marching_squares.cpp"
+}
+
+namespace checkpoint_5
+{
+#include "../checkpoint_5/marching_squares.cpp"
+}
+
+namespace commented_version
+{
+#include "../commented_version/marching_squares.cpp"
+}
+
+namespace non_optimized_results_compilation
+{
+#include "../non_optimized_results_compilation/marching_squares.cpp"
+}
+
+namespace optimized_results_compilation
+{
+#include "../optimized_results_compilation/marching_squares.cpp"
+}
+
+namespace alternative_optimizations
+{
+#include "../alternative_optimizations/marching_squares.cpp"
+}
+
+namespace row_band_kernel
+{
+#include "../row_band_kernel/marching_squares.cpp"
+}
+
+#undef main
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea, con el mismo formato que en las carpetas
+struct LineSegment
+{
+    Point start, end;
+};
+
+// ---------------------------------------------------------------------------
+// Hash del multiconjunto de segmentos
+// Cada segmento se cuantiza a 1/1024 de celda y se ordenan sus extremos
+// La suma de los hashes no depende del orden en que los hilos entregaron los segmentos
+// Cada carpeta tiene su propio tipo de segmento, por eso las funciones son templates
+// ---------------------------------------------------------------------------
+uint64_t mix64(uint64_t z)
+{
+    z += 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+template <typename Segment>
+uint64_t segmentHash(const Segment &segment)
+{
+    int64_t q[4] = {
+        std::llround(segment.start.x * 1024.0), std::llround(segment.start.y * 1024.0),
+        std::llround(segment.end.x * 1024.0), std::llround(segment.end.y * 1024.0)};
+
+    if (q[2] < q[0] || (q[2] == q[0] && q[3] < q[1]))
+    {
+        std::swap(q[0], q[2]);
+        std::swap(q[1], q[3]);
+    }
+
+    uint64_t h = 0;
+    for (int64_t v : q)
+        h = mix64(h ^ (uint64_t)v);
+
+    return h;
+}
+
+struct SegmentSummary
+{
+    std::size_t count;
+    uint64_t hash;
+};
+
+template <typename Segments>
+SegmentSummary summarize(const Segments &segments)
+{
+    uint64_t sum = 0;
+    const long long count = (long long)segments.size();
+
+    #pragma omp parallel for reduction(+ : sum)
+    for (long long i = 0; i < count; ++i)
+        sum += segmentHash(segments[i]);
+
+    return {segments.size(), sum};
+}
+
+// ---------------------------------------------------------------------------
+// Registro de variantes, una por carpeta
+// Cada entrada llama a la función de su carpeta con la malla en el formato que esa carpeta usa:
+//  - prepare() arma ese formato a partir del campo linealizado, fuera de la medición, y devuelve sus bytes
+//    (nullptr si la carpeta recibe el campo linealizado tal cual)
+//  - contour() es lo que se mide: la llamada a la carpeta, el resultado queda guardado hasta la siguiente
+//  - summary() cuenta y hashea ese resultado
+// ---------------------------------------------------------------------------
+struct FieldInput
+{
+    const std::vector<float> *flat;
+    int width, height;
+};
+
+struct Variant
+{
+    const char *name;
+    const char *folder;
+    std::size_t (*prepare)(const FieldInput &field);
+    void (*contour)(const FieldInput &field, float isolevel);
+    SegmentSummary (*summary)();
+};
+
+// Las filas son vectores aparte: a las muestras se suma el encabezado de cada fila
+template <typename Rows>
+std::size_t copyRows(const FieldInput &field, Rows &rows)
+{
+    rows.assign(field.height, typename Rows::value_type(field.width));
+    for (int y = 0; y < field.height; ++y)
+        std::copy(field.flat->begin() + std::size_t(y) * field.width,
+                  field.flat->begin() + std::size_t(y + 1) * field.width,
+                  rows[y].begin());
+
+    return rows.size() * (sizeof(typename Rows::value_type) + field.width * sizeof(float));
+}
+
+template <typename Flat>
+std::size_t copyFlat(const FieldInput &field, Flat &flat)
+{
+    flat.assign(field.flat->begin(), field.flat->end());
+    return flat.size() * sizeof(float);
+}
+
+// checkpoint_1 ... checkpoint_4: malla como vector de vectores, compartida entre las cuatro
+std::vector<std::vector<float>> rowsField;
+
+std::size_t prepareRows(const FieldInput &field)
+{
+    return copyRows(field, rowsField);
+}
+
+// checkpoint_1: secuencial, recibe la lista de isovalues
+std::vector<checkpoint_1::LineSegment> checkpoint1Segments;
+
+void contourCheckpoint1(const FieldInput &field, float isolevel)
+{
+    checkpoint1Segments = checkpoint_1::contourGrid(rowsField, field.width, field.height, {isolevel});
+}
+
+SegmentSummary summaryCheckpoint1()
+{
+    return summarize(checkpoint1Segments);
+}
+
+// checkpoint_2: secuencial con un solo isovalue
+std::vector<checkpoint_2::LineSegment> checkpoint2Segments;
+
+void contourCheckpoint2(const FieldInput &field, float isolevel)
+{
+    checkpoint2Segments = checkpoint_2::contourGrid(rowsField, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryCheckpoint2()
+{
+    return summarize(checkpoint2Segments);
+}
+
+// checkpoint_3 y checkpoint_4: vector privado por hilo
+std::vector<checkpoint_3::LineSegment> checkpoint3Segments;
+
+void contourCheckpoint3(const FieldInput &field, float isolevel)
+{
+    checkpoint3Segments = checkpoint_3::contourGrid(rowsField, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryCheckpoint3()
+{
+    return summarize(checkpoint3Segments);
+}
+
+std::vector<checkpoint_4::LineSegment> checkpoint4Segments;
+
+void contourCheckpoint4(const FieldInput &field, float isolevel)
+{
+    checkpoint4Segments = checkpoint_4::contourGrid(rowsField, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryCheckpoint4()
+{
+    return summarize(checkpoint4Segments);
+}
+
+// checkpoint_5 y commented_version: malla linealizada, reciben el campo tal cual
+std::vector<checkpoint_5::LineSegment> checkpoint5Segments;
+
+void contourCheckpoint5(const FieldInput &field, float isolevel)
+{
+    checkpoint5Segments = checkpoint_5::contourGrid(*field.flat, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryCheckpoint5()
+{
+    return summarize(checkpoint5Segments);
+}
+
+std::vector<commented_version::LineSegment> commentedSegments;
+
+void contourCommented(const FieldInput &field, float isolevel)
+{
+    commentedSegments = commented_version::contourGrid(*field.flat, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryCommented()
+{
+    return summarize(commentedSegments);
+}
+
+// non_optimized_results_compilation: vector de FieldRow con sus contadores de memoria
+non_optimized_results_compilation::ScalarField nonOptimizedField;
+non_optimized_results_compilation::MergedSegments nonOptimizedSegments;
+
+std::size_t prepareNonOptimized(const FieldInput &field)
+{
+    return copyRows(field, nonOptimizedField);
+}
+
+void contourNonOptimized(const FieldInput &field, float isolevel)
+{
+    nonOptimizedSegments = non_optimized_results_compilation::contourGrid(nonOptimizedField, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryNonOptimized()
+{
+    return summarize(nonOptimizedSegments);
+}
+
+// optimized_results_compilation: malla linealizada contada y estadísticas por hilo (vacías sin -DMARCHING_STATS)
+optimized_results_compilation::ScalarField optimizedField;
+std::vector<optimized_results_compilation::CellStats> optimizedStats;
+optimized_results_compilation::MergedSegments optimizedSegments;
+
+std::size_t prepareOptimized(const FieldInput &field)
+{
+    optimizedStats.assign(omp_get_max_threads(), optimized_results_compilation::CellStats());
+    return copyFlat(field, optimizedField);
+}
+
+void contourOptimized(const FieldInput &field, float isolevel)
+{
+    optimizedSegments = optimized_results_compilation::contourGrid(optimizedField, field.width, field.height, isolevel, optimizedStats);
+}
+
+SegmentSummary summaryOptimized()
+{
+    return summarize(optimizedSegments);
+}
+
+// alternative_optimizations: una arena por hilo sobre un pool de bloques, los segmentos quedan en las arenas
+// Como en la carpeta, las arenas se crean una vez (acá por campo) y se reutilizan entre repeticiones
+alternative_optimizations::ScalarField alternativeField;
+std::unique_ptr<alternative_optimizations::ChunkPool> alternativePool;
+std::vector<std::unique_ptr<alternative_optimizations::SegmentArena>> alternativeArenas;
+
+std::size_t prepareAlternative(const FieldInput &field)
+{
+    alternativeArenas.clear();
+    alternativePool.reset(new alternative_optimizations::ChunkPool);
+    for (int t = 0; t < omp_get_max_threads(); ++t)
+        alternativeArenas.emplace_back(new alternative_optimizations::SegmentArena(alternativePool.get()));
+
+    return copyFlat(field, alternativeField);
+}
+
+void contourAlternative(const FieldInput &field, float isolevel)
+{
+    // Cada hilo vacía solo su arena; con menos hilos que arenas (modo roofline) las demás conservarían
+    // los segmentos de la llamada anterior
+    for (auto &arena : alternativeArenas)
+        arena->clear();
+
+    alternative_optimizations::contourGrid(alternativeField, field.width, field.height, isolevel, alternativeArenas);
+}
+
+SegmentSummary summaryAlternative()
+{
+    uint64_t sum = 0;
+    std::size_t count = 0;
+    const int numArenas = (int)alternativeArenas.size();
+
+    #pragma omp parallel for reduction(+ : sum, count)
+    for (int t = 0; t < numArenas; ++t)
+    {
+        for (const auto &segment : *alternativeArenas[t])
+            sum += segmentHash(segment);
+        count += alternativeArenas[t]->size();
+    }
+
+    return {count, sum};
+}
+
+// row_band_kernel: bandas de 8 filas por barrido
+const int BAND_ROWS = 8;
+std::vector<row_band_kernel::LineSegment> bandSegments;
+
+void contourBands(const FieldInput &field, float isolevel)
+{
+    bandSegments = row_band_kernel::contourBands<BAND_ROWS>(*field.flat, field.width, field.height, isolevel);
+}
+
+SegmentSummary summaryBands()
+{
+    return summarize(bandSegments);
+}
+
+// El primero es la referencia contra la que se comparan los demás
+Variant variants[] = {
+    {"checkpoint_1", "checkpoint_1", prepareRows, contourCheckpoint1, summaryCheckpoint1},
+    {"checkpoint_2", "checkpoint_2", prepareRows, contourCheckpoint2, summaryCheckpoint2},
+    {"checkpoint_3", "checkpoint_3", prepareRows, contourCheckpoint3, summaryCheckpoint3},
+    {"checkpoint_4", "checkpoint_4", prepareRows, contourCheckpoint4, summaryCheckpoint4},
+    {"checkpoint_5", "checkpoint_5", nullptr, contourCheckpoint5, summaryCheckpoint5},
+    {"commented", "commented_version", nullptr, contourCommented, summaryCommented},
+    {"non_optimized", "non_optimized_results_compilation", prepareNonOptimized, contourNonOptimized, summaryNonOptimized},
+    {"optimized", "optimized_results_compilation", prepareOptimized, contourOptimized, summaryOptimized},
+    {"arena", "alternative_optimizations", prepareAlternative, contourAlternative, summaryAlternative},
+    {"bandas_k8", "row_band_kernel", nullptr, contourBands, summaryBands},
+};
+
+// ---------------------------------------------------------------------------
+// Campos de prueba con semilla
+// ---------------------------------------------------------------------------
+struct TestField
+{
+    std::string name;
+    float isolevel;
+    std::vector<float> values;
+    float targetCrossed = -1.0f;   // fracción de celdas con contorno pedida, < 0 si el campo no la controla
+};
+
+TestField makeBinaryField(int gridWidth, int gridHeight, unsigned seed)
+{
+    TestField field{"binary", 0.5f, std::vector<float>(std::size_t(gridWidth) * gridHeight)};
+    std::mt19937 rng(seed);
+
+    for (float &v : field.values)
+        v = (float)(rng() % 2);
+
+    return field;
+}
+
+// Función de distancia radial del checkpoint 1, con un desplazamiento aleatorio del centro
+TestField makeRadialField(int gridWidth, int gridHeight, unsigned seed)
+{
+    TestField field{"radial", gridWidth / 4.0f, std::vector<float>(std::size_t(gridWidth) * gridHeight)};
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> jitter(-0.5f, 0.5f);
+
+    Point center = {gridWidth / 2.0f + jitter(rng), gridHeight / 2.0f + jitter(rng)};
+
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float dx = x - center.x;
+            float dy = y - center.y;
+            field.values[std::size_t(y) * gridWidth + x] = std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
+    return field;
+}
+
+// ---------------------------------------------------------------------------
+// Campos de carga de trabajo
+// Lo que decide el rendimiento en datos reales es cuántas celdas tienen contorno, cuántas son saddles y
+// qué fracción de la malla está vacía. El binario aleatorio es casi el peor caso y el radial casi no tiene
+// segmentos, así que estos generadores cubren lo que está en medio. Todos son deterministas por semilla
+// y cada muestra se calcula sola, así se pueden generar en paralelo
+// ---------------------------------------------------------------------------
+
+// Ruido de gradiente (Perlin mejorado) con una permutación que depende de la semilla
+class GradientNoise
+{
+public:
+    explicit GradientNoise(unsigned seed)
+    {
+        std::vector<int> p(256);
+        for (int i = 0; i < 256; ++i)
+            p[i] = i;
+        std::shuffle(p.begin(), p.end(), std::mt19937(seed));
+
+        for (int i = 0; i < 512; ++i)
+            perm_[i] = p[i & 255];
+    }
+
+    // Valor en [-1, 1] aproximadamente
+    float at(float x, float y) const
+    {
+        const int xi = (int)std::floor(x), yi = (int)std::floor(y);
+        const float fx = x - xi, fy = y - yi;
+        const int X = xi & 255, Y = yi & 255;
+
+        const float u = fade(fx), v = fade(fy);
+
+        const float n00 = grad(perm_[perm_[X] + Y], fx, fy);
+        const float n10 = grad(perm_[perm_[X + 1] + Y], fx - 1.0f, fy);
+        const float n01 = grad(perm_[perm_[X] + Y + 1], fx, fy - 1.0f);
+        const float n11 = grad(perm_[perm_[X + 1] + Y + 1], fx - 1.0f, fy - 1.0f);
+
+        const float top = n00 + u * (n10 - n00);
+        const float bottom = n01 + u * (n11 - n01);
+        return top + v * (bottom - top);
+    }
+
+private:
+    int perm_[512];
+
+    static float fade(float t)
+    {
+        return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f);
+    }
+
+    static float grad(int hash, float x, float y)
+    {
+        switch (hash & 7)
+        {
+        case 0: return x + y;
+        case 1: return -x + y;
+        case 2: return x - y;
+        case 3: return -x - y;
+        case 4: return x;
+        case 5: return -x;
+        case 6: return y;
+        default: return -y;
+        }
+    }
+};
+
+// Terreno suave: fBm de 5 octavas; param = cantidad de ondas de la octava base a lo ancho de la malla
+TestField makePerlinField(int gridWidth, int gridHeight, unsigned seed, float param)
+{
+    TestField field{"perlin", 0.0f, std::vector<float>(std::size_t(gridWidth) * gridHeight)};
+    const GradientNoise noise(seed);
+    const float baseFrequency = param / gridWidth;
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        for (int x = 0; x < gridWidth; ++x)
+        {
+            float value = 0.0f, amplitude = 1.0f, frequency = baseFrequency;
+            for (int octave = 0; octave < 5; ++octave)
+            {
+                value += amplitude * noise.at(x * frequency, y * frequency);
+                amplitude *= 0.5f;
+                frequency *= 2.0f;
+            }
+            field.values[std::size_t(y) * gridWidth + x] = value;
+        }
+    }
+
+    return field;
+}
+
+// Suma de gaussianas con centro y ancho aleatorios; param = cantidad de blobs
+// Cada blob se corta a 3 sigmas, así el costo es proporcional al área de los blobs y no a blobs x malla
+TestField makeBlobsField(int gridWidth, int gridHeight, unsigned seed, float param)
+{
+    TestField field{"blobs", 0.5f, std::vector<float>(std::size_t(gridWidth) * gridHeight, 0.0f)};
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> centerX(0.0f, (float)gridWidth), centerY(0.0f, (float)gridHeight);
+    std::uniform_real_distribution<float> width(gridWidth / 128.0f + 1.0f, gridWidth / 16.0f + 1.0f);
+    std::uniform_real_distribution<float> height(0.6f, 1.4f);
+
+    struct Blob
+    {
+        float x, y, sigma, height;
+    };
+    std::vector<Blob> blobs(std::max(1, (int)param));
+    for (Blob &blob : blobs)
+        blob = {centerX(rng), centerY(rng), width(rng), height(rng)};
+
+    // Por filas en paralelo: cada hilo escribe sus filas y recorre los blobs que las tocan
+    #pragma omp parallel for schedule(dynamic, 16)
+    for (int y = 0; y < gridHeight; ++y)
+    {
+        float *row = field.values.data() + std::size_t(y) * gridWidth;
+
+        for (const Blob &blob : blobs)
+        {
+            const float reach = 3.0f * blob.sigma;
+            const float dy = y - blob.y;
+            if (std::fabs(dy) > reach)
+                continue;
+
+            const int x0 = std::max(0, (int)(blob.x - reach));
+            const int x1 = std::min(gridWidth - 1, (int)(blob.x + reach));
+            const float inverse = 1.0f / (2.0f * blob.sigma * blob.sigma);
+
+            for (int x = x0; x <= x1; ++x)
+            {
+                const float dx = x - blob.x;
+                row[x] += blob.height * std::exp(-(dx * dx + dy * dy) * inverse);
+            }
+        }
+    }
+
+    return field;
+}
+
+// Picos aislados sobre un fondo vacío; param = fracción de muestras con pico
+// Casi toda la malla sale por el early exit y cada pico da un rombo de 4 segmentos
+TestField makeSpikesField(int gridWidth, int gridHeight, unsigned seed, float param)
+{
+    TestField field{"spikes", 0.5f, std::vector<float>(std::size_t(gridWidth) * gridHeight, 0.0f)};
+    std::mt19937_64 rng(seed);
+
+    const std::size_t numSpikes = (std::size_t)(param * field.values.size());
+    for (std::size_t i = 0; i < numSpikes; ++i)
+        field.values[rng() % field.values.size()] = 1.0f;
+
+    return field;
+}
+
+// Tablero de ajedrez: todas las celdas son saddles (casos 5 y 10), dos segmentos por celda
+// Es el peor caso real del kernel, peor que el binario aleatorio
+TestField makeSaddlesField(int gridWidth, int gridHeight, unsigned, float)
+{
+    TestField field{"saddles", 0.5f, std::vector<float>(std::size_t(gridWidth) * gridHeight)};
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+        for (int x = 0; x < gridWidth; ++x)
+            field.values[std::size_t(y) * gridWidth + x] = (float)((x + y) & 1);
+
+    return field;
+}
+
+// Ruido de valor con rasgos de tamaño scale más un poco de ruido blanco, como una medición real
+// El ruido blanco corta el contorno en una franja alrededor de cada curva, así que pone un piso a la densidad
+// proporcional a whiteAmplitude
+float densityNoise(const GradientNoise &noise, int x, int y, float scale, float whiteAmplitude, unsigned seed)
+{
+    // Ruido blanco determinista por muestra (hash de x, y, semilla) para no depender del orden
+    uint32_t h = uint32_t(x) * 0x8da6b343u ^ uint32_t(y) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+    h ^= h >> 13;
+    h *= 0x5bd1e995u;
+    h ^= h >> 15;
+    const float white = (h & 0xffff) / 65535.0f - 0.5f;
+
+    return noise.at(x / scale, y / scale) + whiteAmplitude * white;
+}
+
+// Fracción de celdas con contorno en un parche de la esquina, para calibrar la escala
+double crossedFraction(const GradientNoise &noise, int size, float scale, float whiteAmplitude, unsigned seed)
+{
+    std::vector<float> patch(std::size_t(size) * size);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < size; ++y)
+        for (int x = 0; x < size; ++x)
+            patch[std::size_t(y) * size + x] = densityNoise(noise, x, y, scale, whiteAmplitude, seed);
+
+    std::size_t crossed = 0;
+    for (int y = 0; y < size - 1; ++y)
+    {
+        for (int x = 0; x < size - 1; ++x)
+        {
+            const float *top = &patch[std::size_t(y) * size + x];
+            const float *bottom = top + size;
+            int caseIdx = (top[0] >= 0.0f) | (top[1] >= 0.0f) << 1 | (bottom[1] >= 0.0f) << 2 | (bottom[0] >= 0.0f) << 3;
+            crossed += caseIdx != 0 && caseIdx != 15;
+        }
+    }
+
+    return double(crossed) / (double(size - 1) * (size - 1));
+}
+
+// Ruido tipo datos reales con densidad de contorno controlada; param = fracción de celdas con contorno buscada
+// La escala de los rasgos se calibra con bisección sobre un parche de hasta 1024x1024 antes de llenar la malla.
+// La amplitud del ruido blanco baja con la densidad pedida, si no su piso (~1.2 x amplitud) no deja llegar
+// a densidades bajas; la densidad lograda se mide después en main y se compara contra targetCrossed
+TestField makeDensityField(int gridWidth, int gridHeight, unsigned seed, float param)
+{
+    TestField field{"density", 0.0f, std::vector<float>(std::size_t(gridWidth) * gridHeight)};
+    const GradientNoise noise(seed);
+
+    const float target = std::min(0.95f, std::max(1e-4f, param));
+    const float whiteAmplitude = std::min(0.02f, 0.4f * target);
+    const int patch = std::min(1024, std::min(gridWidth, gridHeight));
+    field.targetCrossed = target;
+
+    // Más escala -> rasgos más grandes -> menos celdas con contorno
+    float low = 0.25f, high = 4096.0f;
+    for (int i = 0; i < 24; ++i)
+    {
+        float middle = std::sqrt(low * high);
+        if (crossedFraction(noise, patch, middle, whiteAmplitude, seed) > target)
+            low = middle;
+        else
+            high = middle;
+    }
+    const float scale = std::sqrt(low * high);
+
+    #pragma omp parallel for schedule(static)
+    for (int y = 0; y < gridHeight; ++y)
+        for (int x = 0; x < gridWidth; ++x)
+            field.values[std::size_t(y) * gridWidth + x] = densityNoise(noise, x, y, scale, whiteAmplitude, seed);
+
+    return field;
+}
+
+// Diferencia relativa aceptada entre la densidad lograda y la buscada
+const double DENSITY_TOLERANCE = 0.25;
+
+struct FieldGenerator
+{
+    const char *name;
+    float defaultParam;
+    TestField (*make)(int gridWidth, int gridHeight, unsigned seed, float param);
+};
+
+TestField makeBinary(int gridWidth, int gridHeight, unsigned seed, float)
+{
+    return makeBinaryField(gridWidth, gridHeight, seed);
+}
+
+TestField makeRadial(int gridWidth, int gridHeight, unsigned seed, float)
+{
+    return makeRadialField(gridWidth, gridHeight, seed);
+}
+
+const FieldGenerator generators[] = {
+    {"binary", 0.0f, makeBinary},
+    {"radial", 0.0f, makeRadial},
+    {"perlin", 8.0f, makePerlinField},
+    {"blobs", 64.0f, makeBlobsField},
+    {"spikes", 0.001f, makeSpikesField},
+    {"saddles", 0.0f, makeSaddlesField},
+    {"density", 0.05f, makeDensityField},
+};
+
+// Lista separada por comas, cada campo con parámetro opcional: "perlin:16,density:0.2,spikes"
+// "all" son todos los generadores con su parámetro por defecto
+std::vector<TestField> makeFields(const std::string &spec, int gridWidth, int gridHeight, unsigned seed)
+{
+    std::vector<TestField> fields;
+    std::string list = spec;
+
+    if (list == "all")
+    {
+        list.clear();
+        for (const FieldGenerator &generator : generators)
+            list += std::string(list.empty() ? "" : ",") + generator.name;
+    }
+
+    std::size_t start = 0;
+    while (start <= list.size())
+    {
+        std::size_t comma = list.find(',', start);
+        if (comma == std::string::npos)
+            comma = list.size();
+
+        std::string item = list.substr(start, comma - start);
+        start = comma + 1;
+        if (item.empty())
+            continue;
+
+        std::string name = item;
+        std::string paramText;
+        std::size_t colon = item.find(':');
+        if (colon != std::string::npos)
+        {
+            name = item.substr(0, colon);
+            paramText = item.substr(colon + 1);
+        }
+
+        const FieldGenerator *generator = nullptr;
+        for (const FieldGenerator &candidate : generators)
+            if (name == candidate.name)
+                generator = &candidate;
+
+        if (generator == nullptr)
+        {
+            std::cout << "Campo desconocido '" << name << "', se ignora." << std::endl;
+            continue;
+        }
+
+        const float param = paramText.empty() ? generator->defaultParam : std::stof(paramText);
+        fields.push_back(generator->make(gridWidth, gridHeight, seed, param));
+
+        if (!paramText.empty())
+            fields.back().name += ":" + paramText;
+    }
+
+    return fields;
+}
+
+// Celdas con contorno y saddles del campo, lo que más pesa en el tiempo del kernel
+struct FieldProfile
+{
+    double crossed, saddles;
+};
+
+FieldProfile profileField(const TestField &testField, int gridWidth, int gridHeight)
+{
+    std::size_t crossed = 0, saddles = 0;
+    const float isolevel = testField.isolevel;
+
+    #pragma omp parallel for schedule(static) reduction(+ : crossed, saddles)
+    for (int y = 0; y < gridHeight - 1; ++y)
+    {
+        const float *top = testField.values.data() + std::size_t(y) * gridWidth;
+        const float *bottom = top + gridWidth;
+
+        for (int x = 0; x < gridWidth - 1; ++x)
+        {
+            int caseIdx = (top[x] >= isolevel) | (top[x + 1] >= isolevel) << 1 |
+                          (bottom[x + 1] >= isolevel) << 2 | (bottom[x] >= isolevel) << 3;
+            crossed += caseIdx != 0 && caseIdx != 15;
+            saddles += caseIdx == 5 || caseIdx == 10;
+        }
+    }
+
+    const double cells = double(gridWidth - 1) * (gridHeight - 1);
+    return {crossed / cells, saddles / cells};
+}
+
+// ---------------------------------------------------------------------------
+// Roofline
+// Se miden los dos techos de la máquina para cada número de hilos:
+//  - ancho de banda con un triad estilo STREAM (a = b + s * c, 24 B por elemento)
+//  - GFLOP/s alcanzables con 8 acumuladores independientes de multiply-add por hilo
+// Y para cada variante se cuentan el trabajo y el tráfico en una corrida aparte, con counting activo:
+//  - flops: 4 comparaciones por celda + las llamadas a lerp contadas por el hook, con el costo de cada camino
+//  - bytes: el campo en el formato que recibe la carpeta (se lee una vez), lo reservado durante la corrida (cada
+//    bloque nuevo se llena: vectores por celda, buffers por hilo y sus copias al crecer, vector global, bloques de
+//    la arena) y lo que se vuelve a leer de esos bloques, que es todo menos el resultado final (16 B por segmento)
+// ---------------------------------------------------------------------------
+const double FLOPS_PER_CELL_COMPARE = 4.0;
+
+// Operaciones de lerp en punto flotante: v2 - v1, |denom| < EPS, (iso - v1) / denom y p1 + t * (p2 - p1) en x e y
+const double FLOPS_PER_LERP = 1 + 1 + 2 + 2 * 3;
+
+// Con |denom| < EPS sale después de la resta y la comparación
+const double FLOPS_PER_DEGENERATE_LERP = 2;
+
+struct RunCounts
+{
+    long long lerps = 0;
+    long long degenerateLerps = 0;
+    long long allocated = 0;
+    std::size_t segments = 0;
+};
+
+// Corre la variante una vez contando lerp y reservas; prepare() se llama justo antes para que las arenas
+// partan vacías y sus bloques aparezcan como reservas, igual que los vectores de las demás variantes
+RunCounts countRun(const Variant &variant, const FieldInput &input, float isolevel, std::size_t &fieldBytes)
+{
+    fieldBytes = variant.prepare ? variant.prepare(input) : input.flat->size() * sizeof(float);
+
+    std::fill(lerpCounters.begin(), lerpCounters.end(), LerpCounter());
+    allocatedBytes = 0;
+
+    counting = true;
+    variant.contour(input, isolevel);
+    counting = false;
+
+    RunCounts counts;
+    for (const LerpCounter &counter : lerpCounters)
+    {
+        counts.lerps += counter.calls;
+        counts.degenerateLerps += counter.degenerate;
+    }
+    counts.allocated = allocatedBytes;
+    counts.segments = variant.summary().count;
+
+    return counts;
+}
+
+double measureBandwidth(int threads)
+{
+    const std::size_t n = std::size_t(1) << 23;
+    std::vector<double> a(n), b(n), c(n);
+    const double scalar = 3.0;
+    double best = 0.0;
+
+    #pragma omp parallel for num_threads(threads) schedule(static)
+    for (std::size_t i = 0; i < n; ++i)
+    {
+        a[i] = 0.0;
+        b[i] = 1.0;
+        c[i] = 2.0;
+    }
+
+    for (int r = 0; r < 5; ++r)
+    {
+        double startTime = omp_get_wtime();
+
+        #pragma omp parallel for num_threads(threads) schedule(static)
+        for (std::size_t i = 0; i < n; ++i)
+            a[i] = b[i] + scalar * c[i];
+
+        double seconds = omp_get_wtime() - startTime;
+        best = std::max(best, 3.0 * sizeof(double) * n / seconds / 1e9);
+    }
+
+    return best;
+}
+
+double measureComputePeak(int threads)
+{
+    const long long iterations = 50000000;
+    double best = 0.0;
+
+    for (int r = 0; r < 3; ++r)
+    {
+        float sink = 0.0f;
+        double startTime = omp_get_wtime();
+
+        #pragma omp parallel num_threads(threads) reduction(+ : sink)
+        {
+            float acc[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+            const float mul = 0.999999f, add = 1e-7f;
+
+            for (long long i = 0; i < iterations; ++i)
+                for (int k = 0; k < 8; ++k)
+                    acc[k] = acc[k] * mul + add;
+
+            for (int k = 0; k < 8; ++k)
+                sink += acc[k];
+        }
+
+        double seconds = omp_get_wtime() - startTime;
+        best = std::max(best, 2.0 * 8 * iterations * threads / seconds / 1e9);
+
+        // Evita que el compilador elimine el loop
+        volatile float keep = sink;
+        (void)keep;
+    }
+
+    return best;
+}
+
+// Corre cada variante con 1, 2, 4, ... hilos y escribe roofline.txt para results_visualizer/plot_roofline.py
+void runRoofline(const std::vector<TestField> &fields, int gridWidth, int gridHeight, int repetitions)
+{
+    const std::string outputFilename = "roofline.txt";
+    const int maxThreads = omp_get_max_threads();
+
+    std::vector<int> threadCounts;
+    for (int t = 1; t < maxThreads; t *= 2)
+        threadCounts.push_back(t);
+    threadCounts.push_back(maxThreads);
+
+    std::ofstream outputFile(outputFilename);
+    outputFile << "maquina,hilos,ancho_de_banda_gbs,pico_gflops\n";
+
+    for (int threads : threadCounts)
+    {
+        double bandwidth = measureBandwidth(threads);
+        double peak = measureComputePeak(threads);
+
+        std::cout << threads << " hilos: " << bandwidth << " GB/s, " << peak << " GFLOP/s." << std::endl;
+        outputFile << "maquina," << threads << "," << bandwidth << "," << peak << "\n";
+    }
+
+    outputFile << "variante,campo,hilos,resolucion,ms,celdas,segmentos,lerps,flops,bytes\n";
+
+    const double cells = double(gridWidth - 1) * (gridHeight - 1);
+    lerpCounters.assign(maxThreads, LerpCounter());
+
+    for (const TestField &testField : fields)
+    {
+        FieldInput input{&testField.values, gridWidth, gridHeight};
+
+        for (const Variant &variant : variants)
+        {
+            for (int threads : threadCounts)
+            {
+                omp_set_num_threads(threads);
+
+                std::size_t fieldBytes = 0;
+                const RunCounts counts = countRun(variant, input, testField.isolevel, fieldBytes);
+
+                double minMs = 1e300;
+                for (int r = 0; r < repetitions; ++r)
+                {
+                    double startTime = omp_get_wtime();
+                    variant.contour(input, testField.isolevel);
+                    minMs = std::min(minMs, (omp_get_wtime() - startTime) * 1000.0);
+                }
+
+                const double fullLerps = double(counts.lerps - counts.degenerateLerps);
+                const double flops = FLOPS_PER_CELL_COMPARE * cells + FLOPS_PER_LERP * fullLerps +
+                                     FLOPS_PER_DEGENERATE_LERP * counts.degenerateLerps;
+
+                const double resultBytes = double(sizeof(LineSegment) * counts.segments);
+                const double readBack = std::max(0.0, counts.allocated - resultBytes);
+                const double bytes = double(fieldBytes) + counts.allocated + readBack;
+
+                outputFile << "variante," << variant.name << "," << testField.name << "," << threads << ","
+                           << gridWidth << "," << minMs << "," << cells << "," << counts.segments << ","
+                           << counts.lerps << "," << flops << "," << bytes << "\n";
+
+                std::cout << variant.name << " (" << testField.name << ", " << threads << " hilos): " << minMs << " ms, "
+                          << counts.lerps << " lerps, " << counts.allocated / 1e6 << " MB reservados, "
+                          << flops / (minMs * 1e-3) / 1e9 << " GFLOP/s, " << bytes / (minMs * 1e-3) / 1e9 << " GB/s, "
+                          << flops / bytes << " flop/byte." << std::endl;
+            }
+        }
+    }
+
+    omp_set_num_threads(maxThreads);
+    std::cout << "Se escribió " << outputFilename << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 2000;
+    int repetitions = 5;
+    unsigned seed = 42;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: repeticiones por variante
+    // Tercer argumento: semilla de los campos
+    // Cuarto argumento en adelante: "roofline" para medir la máquina y escribir roofline.txt, o la lista de
+    // campos (por ejemplo "perlin,blobs:256,density:0.1" o "all"); por defecto binary y radial
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        repetitions = std::stoi(argv[2]);
+
+    if (argc > 3)
+        seed = (unsigned)std::stoul(argv[3]);
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+
+    bool roofline = false;
+    std::string fieldSpec = "binary,radial";
+
+    for (int i = 4; i < argc; ++i)
+    {
+        if (std::string(argv[i]) == "roofline")
+            roofline = true;
+        else if (argv[i][0] != '\0')
+            fieldSpec = argv[i];
+    }
+
+    std::vector<TestField> fields = makeFields(fieldSpec, gridWidth, gridHeight, seed);
+
+    if (roofline)
+    {
+        runRoofline(fields, gridWidth, gridHeight, repetitions);
+        return 0;
+    }
+
+    int mismatches = 0;
+
+    for (const TestField &testField : fields)
+    {
+        const FieldProfile profile = profileField(testField, gridWidth, gridHeight);
+
+        std::cout << "\nCampo " << testField.name << " " << gridWidth << "x" << gridHeight
+                  << " (semilla " << seed << ", " << omp_get_max_threads() << " hilos, " << std::fixed << std::setprecision(2)
+                  << 100.0 * profile.crossed << "% celdas con contorno, " << 100.0 * profile.saddles << "% saddles)"
+                  << std::defaultfloat << std::setprecision(6) << std::endl;
+
+        // El nombre lleva la densidad pedida; si la lograda se aleja mucho los tiempos no son de esa densidad
+        if (testField.targetCrossed >= 0.0f)
+        {
+            const double target = testField.targetCrossed;
+            std::cout << std::fixed << std::setprecision(2) << "Densidad buscada " << 100.0 * target << "%, lograda "
+                      << 100.0 * profile.crossed << "%" << std::defaultfloat << std::setprecision(6) << std::endl;
+            if (std::fabs(profile.crossed - target) > DENSITY_TOLERANCE * target)
+                std::cout << "Aviso: la densidad lograda se aleja más de " << 100.0 * DENSITY_TOLERANCE
+                          << "% de la buscada." << std::endl;
+        }
+        std::cout << std::left << std::setw(18) << "variante" << std::right
+                  << std::setw(12) << "min ms" << std::setw(12) << "prom ms" << std::setw(12) << "speedup"
+                  << std::setw(14) << "segmentos" << std::setw(20) << "hash" << "  resultado" << std::endl;
+
+        FieldInput input{&testField.values, gridWidth, gridHeight};
+
+        double referenceMs = 0.0;
+        std::size_t referenceCount = 0;
+        uint64_t referenceHash = 0;
+
+        for (std::size_t v = 0; v < sizeof(variants) / sizeof(variants[0]); ++v)
+        {
+            const Variant &variant = variants[v];
+            if (variant.prepare)
+                variant.prepare(input);
+
+            double minMs = 1e300, totalMs = 0.0;
+
+            for (int r = 0; r < repetitions; ++r)
+            {
+                double startTime = omp_get_wtime();
+                variant.contour(input, testField.isolevel);
+                double elapsedMs = (omp_get_wtime() - startTime) * 1000.0;
+
+                minMs = std::min(minMs, elapsedMs);
+                totalMs += elapsedMs;
+            }
+
+            const SegmentSummary result = variant.summary();
+
+            if (v == 0)
+            {
+                referenceMs = minMs;
+                referenceCount = result.count;
+                referenceHash = result.hash;
+            }
+
+            bool ok = result.count == referenceCount && result.hash == referenceHash;
+            if (!ok)
+                ++mismatches;
+
+            std::cout << std::left << std::setw(18) << variant.name << std::right << std::fixed << std::setprecision(2)
+                      << std::setw(12) << minMs << std::setw(12) << totalMs / repetitions
+                      << std::setw(12) << referenceMs / minMs
+                      << std::setw(14) << result.count
+                      << "  " << std::hex << std::setw(16) << std::setfill('0') << result.hash << std::dec << std::setfill(' ')
+                      << "  " << (ok ? "OK" : "DIFERENTE") << std::endl;
+        }
+
+        std::cout << std::defaultfloat;
+    }
+
+    std::cout << "\nVariantes:" << std::endl;
+    for (const Variant &variant : variants)
+        std::cout << "  " << variant.name << ": " << variant.folder << std::endl;
+
+    if (mismatches > 0)
+    {
+        std::cout << "\n" << mismatches << " resultados no coinciden con la referencia." << std::endl;
+        return 1;
+    }
+
+    std::cout << "\nTodas las variantes generan los mismos segmentos." << std::endl;
+    return 0;
+}
@@ -0,0 +1,28 @@
+set -e
+
+CPP_SOURCE="marching_squares.cpp"
+EXECUTABLE_NAME="suite"
+
+if [ -n "$4" ]; then
+  export OMP_NUM_THREADS=$4
+fi
+
+echo "Compilando el ejecutable: $CPP_SOURCE con OpenMP support..."
+g++ -O3 -fopenmp "$CPP_SOURCE" -o "$EXECUTABLE_NAME" -std=c++17
+echo "Compilación exitosa. Ejecutable creado: $EXECUTABLE_NAME"
+echo ""
+
+echo "Corriendo el ejecutable..."
+# Del quinto argumento en adelante van al ejecutable: "roofline" y la lista de campos se pueden combinar
+GRID_SIZE=$1
+REPETITIONS=$2
+SEED=$3
+if [ $# -gt 4 ]; then
+  shift 4
+else
+  set --
+fi
+./"$EXECUTABLE_NAME" "$GRID_SIZE" "$REPETITIONS" "$SEED" "$@"
+echo ""
+
+echo "Proceso completado."
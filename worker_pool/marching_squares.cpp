@@ -0,0 +1,459 @@
+#include <string>
+#include <algorithm>
+#include <vector>
+#include <cmath>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <memory>
+#include <random>
+#include <iostream>
+#include <omp.h>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+// Struct para puntos en 2D
+struct Point
+{
+    float x, y;
+};
+
+// Struct para segmentos de línea
+// Consiste de 2 puntos en 2D
+struct LineSegment
+{
+    Point start, end;
+};
+
+// Se usa solo para el linear interpolation
+float EPS = 1e-6f;
+
+// Usamos linear interpolation
+// Calcula en qué parte del borde entre dos puntos cae el isovalue
+Point lerp(Point p1, Point p2, float v1, float v2, float iso)
+{
+    float denom = v2 - v1;
+
+    if (std::fabs(denom) < EPS)
+        return p1;
+
+    float t = (iso - v1) / denom;
+
+    return {p1.x + t * (p2.x - p1.x),
+            p1.y + t * (p2.y - p1.y)};
+}
+
+// TOP -> RIGHT -> BOTTOM -> LEFT
+int edgeCorners[4][2] = {
+    {0, 1}, {1, 2}, {2, 3}, {3, 0}};
+
+int edgePairs[16][4] = {
+    {-1, -1, -1, -1}, // 0   0000
+    {3, 0, -1, -1},   // 1   0001
+    {0, 1, -1, -1},   // 2   0010
+    {3, 1, -1, -1},   // 3   0011
+    {1, 2, -1, -1},   // 4   0100
+    {0, 1, 3, 2},     // 5   0101
+    {0, 2, -1, -1},   // 6   0110
+    {3, 2, -1, -1},   // 7   0111
+    {2, 3, -1, -1},   // 8   1000
+    {0, 2, -1, -1},   // 9   1001
+    {0, 3, 1, 2},     // 10  1010
+    {1, 2, -1, -1},   // 11  1011
+    {3, 1, -1, -1},   // 12  1100
+    {0, 1, -1, -1},   // 13  1101
+    {3, 0, -1, -1},   // 14  1110
+    {-1, -1, -1, -1}  // 15  1111
+};
+
+// Calcula los segmentos de línea para una casilla 2x2 (un square)
+void marchSquare(float cell_x, float cell_y,
+                 float values[4],
+                 float isolevel,
+                 std::vector<LineSegment>& outSegments)
+{
+    int caseIdx = 0;
+
+    if (values[0] >= isolevel) caseIdx |= 1;
+    if (values[1] >= isolevel) caseIdx |= 2;
+    if (values[2] >= isolevel) caseIdx |= 4;
+    if (values[3] >= isolevel) caseIdx |= 8;
+
+    if (caseIdx == 0 || caseIdx == 15)
+        return;
+
+    Point corners[4] = {
+        {cell_x, cell_y},
+        {cell_x + 1, cell_y},
+        {cell_x + 1, cell_y + 1},
+        {cell_x, cell_y + 1}
+    };
+
+    auto getEdgePoint = [&](int e) -> Point
+    {
+        int c0 = edgeCorners[e][0], c1 = edgeCorners[e][1];
+        return lerp(corners[c0], corners[c1],
+                    values[c0], values[c1],
+                    isolevel);
+    };
+
+    int *pair = edgePairs[caseIdx];
+
+    for (int i = 0; i < 4 && pair[i] != -1; i += 2)
+    {
+        outSegments.push_back({getEdgePoint(pair[i]), getEdgePoint(pair[i + 1])});
+    }
+}
+
+
+// Una fila de celdas con el sliding window del checkpoint 5
+void marchRow(const float *scalarField, int gridWidth, int y, float isolevel, std::vector<LineSegment> &out)
+{
+    const float *top = scalarField + std::size_t(y) * gridWidth;
+    const float *bottom = top + gridWidth;
+
+    float left_top_val = top[0];
+    float left_bottom_val = bottom[0];
+
+    for (int x = 0; x < gridWidth - 1; ++x)
+    {
+        float right_top_val = top[x + 1];
+        float right_bottom_val = bottom[x + 1];
+
+        float values[4] = {
+            left_top_val,
+            right_top_val,
+            right_bottom_val,
+            left_bottom_val
+        };
+
+        marchSquare((float)x, (float)y, values, isolevel, out);
+
+        left_top_val = right_top_val;
+        left_bottom_val = right_bottom_val;
+    }
+}
+
+// Lo que se hace hoy: una región paralela por llamada con un buffer por hilo (alternative_optimizations)
+void contourOpenMP(const std::vector<float> &scalarField, int gridWidth, int gridHeight, float isolevel,
+                   std::vector<LineSegment> &allSegments)
+{
+    const int numThreads = omp_get_max_threads();
+    std::vector<std::vector<LineSegment>> threadSegments(numThreads);
+
+    #pragma omp parallel num_threads(numThreads)
+    {
+        std::vector<LineSegment> &mySegs = threadSegments[omp_get_thread_num()];
+
+        #pragma omp for nowait schedule(static)
+        for (int y = 0; y < gridHeight - 1; ++y)
+            marchRow(scalarField.data(), gridWidth, y, isolevel, mySegs);
+    }
+
+    std::vector<std::size_t> offsets(numThreads + 1, 0);
+    for (int t = 0; t < numThreads; ++t)
+        offsets[t + 1] = offsets[t] + threadSegments[t].size();
+
+    allSegments.resize(offsets[numThreads]);
+
+    #pragma omp parallel for num_threads(numThreads)
+    for (int t = 0; t < numThreads; ++t)
+        std::copy(threadSegments[t].begin(), threadSegments[t].end(), allSegments.begin() + offsets[t]);
+}
+
+// ---------------------------------------------------------------------------
+// Pool de workers persistente
+//  - Los hilos se crean una vez y se fijan a un core (en Linux)
+//  - Esperan el siguiente trabajo girando SPIN_ITERATIONS veces y después se duermen en una condition_variable
+//  - Cada worker conserva su buffer de segmentos entre llamadas (clear() no libera la capacidad)
+//  - El hilo que llama también trabaja como participante 0
+// ---------------------------------------------------------------------------
+inline void cpuRelax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+const int SPIN_ITERATIONS = 4096;
+
+// Gira un rato y después cede el core, por si hay más hilos que cores
+template <typename Predicate>
+void spinUntil(Predicate done)
+{
+    for (int spin = 0; !done(); ++spin)
+    {
+        if (spin < SPIN_ITERATIONS)
+            cpuRelax();
+        else
+            std::this_thread::yield();
+    }
+}
+const int ROWS_PER_CHUNK = 8;
+const std::size_t INITIAL_SEGMENTS_PER_WORKER = std::size_t(1) << 16;
+
+class ContourPool
+{
+public:
+    explicit ContourPool(int participants)
+        : numParticipants(std::max(1, participants)), states(numParticipants)
+    {
+        for (WorkerState &s : states)
+            s.segments.reserve(INITIAL_SEGMENTS_PER_WORKER);
+
+        // Con más participantes que cores no se fija nada: varios hilos en el mismo core se estorban
+        const bool pin = numParticipants <= (int)std::thread::hardware_concurrency();
+
+        for (int id = 1; id < numParticipants; ++id)
+            workers.emplace_back(&ContourPool::workerLoop, this, id, pin);
+    }
+
+    ~ContourPool()
+    {
+        stop.store(true);
+        wakeWorkers();
+
+        for (std::thread &w : workers)
+            w.join();
+    }
+
+    int size() const { return numParticipants; }
+
+    // Calcula los segmentos de la malla en out (se reutiliza su capacidad entre llamadas)
+    void contour(const float *field, int width, int height, float isolevel, std::vector<LineSegment> &out)
+    {
+        job.field = field;
+        job.width = width;
+        job.height = height;
+        job.isolevel = isolevel;
+        job.out = &out;
+        job.nextRow.store(0, std::memory_order_relaxed);
+        job.arrived.store(0, std::memory_order_relaxed);
+        job.offsetsReady.store(false, std::memory_order_relaxed);
+        pending.store(numParticipants, std::memory_order_relaxed);
+
+        wakeWorkers();
+        runJob(0);
+
+        spinUntil([&] { return pending.load(std::memory_order_acquire) == 0; });
+    }
+
+private:
+    struct alignas(64) WorkerState
+    {
+        std::vector<LineSegment> segments;
+        std::size_t offset = 0;
+    };
+
+    struct Job
+    {
+        const float *field = nullptr;
+        int width = 0, height = 0;
+        float isolevel = 0.0f;
+        std::vector<LineSegment> *out = nullptr;
+
+        alignas(64) std::atomic<int> nextRow{0};
+        alignas(64) std::atomic<int> arrived{0};
+        std::atomic<bool> offsetsReady{false};
+    };
+
+    void wakeWorkers()
+    {
+        generation.fetch_add(1);
+
+        // Solo se toma el lock si alguien está dormido; los que giran ven el cambio de generation solos
+        if (parked.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(parkMutex);
+            parkCondition.notify_all();
+        }
+    }
+
+    void workerLoop(int id, bool pin)
+    {
+        if (pin)
+            pinToCore(id);
+
+        unsigned long long seen = 0;
+
+        while (true)
+        {
+            unsigned long long current = generation.load(std::memory_order_acquire);
+
+            for (int spin = 0; spin < SPIN_ITERATIONS && current == seen; ++spin)
+            {
+                cpuRelax();
+                current = generation.load(std::memory_order_acquire);
+            }
+
+            if (current == seen)
+            {
+                std::unique_lock<std::mutex> lock(parkMutex);
+                parked.fetch_add(1);
+                parkCondition.wait(lock, [&] { return generation.load() != seen; });
+                parked.fetch_sub(1);
+                current = generation.load();
+            }
+
+            seen = current;
+
+            if (stop.load())
+                return;
+
+            runJob(id);
+        }
+    }
+
+    void runJob(int id)
+    {
+        WorkerState &state = states[id];
+        state.segments.clear();
+
+        const int cellRows = job.height - 1;
+
+        // Filas en bloques de ROWS_PER_CHUNK tomados con un contador atómico
+        while (true)
+        {
+            int begin = job.nextRow.fetch_add(ROWS_PER_CHUNK, std::memory_order_relaxed);
+            if (begin >= cellRows)
+                break;
+
+            int end = std::min(cellRows, begin + ROWS_PER_CHUNK);
+            for (int y = begin; y < end; ++y)
+                marchRow(job.field, job.width, y, job.isolevel, state.segments);
+        }
+
+        // Barrera: el último en llegar calcula los offsets y dimensiona la salida
+        if (job.arrived.fetch_add(1, std::memory_order_acq_rel) + 1 == numParticipants)
+        {
+            std::size_t total = 0;
+            for (WorkerState &s : states)
+            {
+                s.offset = total;
+                total += s.segments.size();
+            }
+
+            job.out->resize(total);
+            job.offsetsReady.store(true, std::memory_order_release);
+        }
+        else
+        {
+            spinUntil([&] { return job.offsetsReady.load(std::memory_order_acquire); });
+        }
+
+        std::copy(state.segments.begin(), state.segments.end(), job.out->begin() + state.offset);
+
+        pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    static void pinToCore(int id)
+    {
+#ifdef __linux__
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(id, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)id;
+#endif
+    }
+
+    const int numParticipants;
+    std::vector<WorkerState> states;
+    std::vector<std::thread> workers;
+
+    Job job;
+    alignas(64) std::atomic<unsigned long long> generation{0};
+    alignas(64) std::atomic<int> pending{0};
+    std::atomic<int> parked{0};
+    std::atomic<bool> stop{false};
+
+    std::mutex parkMutex;
+    std::condition_variable parkCondition;
+};
+
+// ---------------------------------------------------------------------------
+// Latencia por llamada
+// ---------------------------------------------------------------------------
+struct LatencyReport
+{
+    double mean, p50, p99, max;
+};
+
+LatencyReport summarize(std::vector<double> times)
+{
+    std::sort(times.begin(), times.end());
+
+    double sum = 0.0;
+    for (double t : times)
+        sum += t;
+
+    auto percentile = [&](double p) { return times[std::min(times.size() - 1, (std::size_t)(p * times.size()))]; };
+
+    return {sum / times.size(), percentile(0.50), percentile(0.99), times.back()};
+}
+
+void printReport(const char *label, const LatencyReport &r, std::size_t segments)
+{
+    std::cout << label << ": promedio " << r.mean << " ms, p50 " << r.p50 << " ms, p99 " << r.p99
+              << " ms, máximo " << r.max << " ms (" << segments << " segmentos)." << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+    int gridResolution = 500;
+    int calls = 200;
+
+    // Primer argumento: tamaño de la malla
+    // Segundo argumento: cuántas llamadas seguidas
+    if (argc > 1)
+        gridResolution = std::stoi(argv[1]);
+
+    if (argc > 2)
+        calls = std::max(1, std::stoi(argv[2]));
+
+    const int gridWidth = gridResolution;
+    const int gridHeight = gridResolution;
+    const float isolevel = 0.5f;
+
+    std::cout << "\nResolución de la malla: " << gridWidth << "x" << gridHeight << ", " << calls << " llamadas, "
+              << omp_get_max_threads() << " hilos" << std::endl;
+
+    // Varios campos distintos, como peticiones distintas
+    std::mt19937 rng(2024);
+    std::vector<std::vector<float>> fields(8, std::vector<float>(std::size_t(gridWidth) * gridHeight));
+    for (auto &field : fields)
+        for (float &v : field)
+            v = (float)(rng() % 2);
+
+    std::vector<LineSegment> segments;
+    std::vector<double> times(calls);
+
+    for (int i = 0; i < calls; ++i)
+    {
+        double startTime = omp_get_wtime();
+        contourOpenMP(fields[i % fields.size()], gridWidth, gridHeight, isolevel, segments);
+        times[i] = (omp_get_wtime() - startTime) * 1000.0;
+    }
+    printReport("OpenMP por llamada", summarize(times), segments.size());
+
+    ContourPool pool(omp_get_max_threads());
+
+    for (int i = 0; i < calls; ++i)
+    {
+        double startTime = omp_get_wtime();
+        pool.contour(fields[i % fields.size()].data(), gridWidth, gridHeight, isolevel, segments);
+        times[i] = (omp_get_wtime() - startTime) * 1000.0;
+    }
+    printReport("Pool persistente", summarize(times), segments.size());
+
+    return 0;
+}